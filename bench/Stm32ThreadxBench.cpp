@@ -0,0 +1,428 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+#include "Stm32ThreadxBench.hpp"
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include "Stm32ThreadxThread.hpp"
+#include "Stm32ThreadxSemaphore.hpp"
+#include "Stm32ThreadxQueue.hpp"
+#include "Stm32ThreadxMutex.hpp"
+#include "Stm32ThreadxEventFlags.hpp"
+
+#ifndef STM32THREADXTHREAD_HAS_CYCLE_CLOCK
+#error "the benchmarks need cycle_clock, define STM32THREADXTHREAD_CYCLE_CLOCK_HZ"
+#endif
+#ifdef TX_DISABLE_NOTIFY_CALLBACKS
+#error "the benchmarks need thread::join(), don't define TX_DISABLE_NOTIFY_CALLBACKS"
+#endif
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+namespace {
+    constexpr thread::priority::value_type RUNNER_PRIORITY = STM32THREADXTHREAD_BENCH_PRIORITY;
+    constexpr thread::priority::value_type HIGH_PRIORITY = RUNNER_PRIORITY - 1;
+    constexpr thread::priority::value_type LOW_PRIORITY = RUNNER_PRIORITY + 1;
+    constexpr std::size_t STACK_SIZE = 2048;
+    constexpr std::uint32_t MAX_SLEEP_ITERATIONS = 100;
+
+    class collector {
+    public:
+        void add(cycle_clock::duration d) {
+            const auto cycles = d.count();
+            min = std::min(min, cycles);
+            max = std::max(max, cycles);
+            sum += cycles;
+            ++samples;
+        }
+
+        bench::result finish(const char *name) const {
+            return {
+                name, samples, samples ? min : 0, max,
+                samples ? static_cast<std::uint32_t>(sum / samples) : 0
+            };
+        }
+
+    private:
+        std::uint32_t samples{};
+        std::uint32_t min{UINT32_MAX};
+        std::uint32_t max{};
+        std::uint64_t sum{};
+    };
+
+    bench::report_fn report = nullptr;
+    bench::done_fn done = nullptr;
+    std::uint32_t iterations = 0;
+    std::uint32_t groups = 0;
+
+    volatile bool stop = false;
+    volatile cycle_clock::rep stamp = 0;
+    void (*partner_body)() = nullptr;
+
+    void runnerEntry(ULONG);
+
+    static_thread<STACK_SIZE> runner(&runnerEntry, ULONG{0}, RUNNER_PRIORITY, "bench");
+    static_thread<STACK_SIZE> partner([]() { partner_body(); }, LOW_PRIORITY, "bench partner");
+
+    TX_THREAD raw_partner;
+    alignas(8) UCHAR raw_stack[STACK_SIZE];
+
+    void emptyEntry(ULONG) {
+    }
+
+    /**
+     * Restarts the partner thread with a new body, the previous run must have completed.
+     */
+    void startPartner(void (*body)(), thread::priority::value_type prio) {
+        if (partner.getState() == thread::state::completed) {
+            partner.reset();
+        }
+        stop = false;
+        partner_body = body;
+        partner.setPriority(prio);
+        partner.resume();
+    }
+
+    void startRawPartner(void (*entry)(ULONG), UINT prio) {
+        stop = false;
+        auto result = tx_thread_create(&raw_partner, const_cast<char *>("bench raw"), entry, 0, raw_stack,
+                                       sizeof(raw_stack), prio, prio, TX_NO_TIME_SLICE, TX_AUTO_START);
+        assert(result == TX_SUCCESS);
+        (void) result;
+    }
+
+    void deleteRawPartner() {
+        tx_thread_terminate(&raw_partner);
+        tx_thread_delete(&raw_partner);
+    }
+
+    void benchYield() {
+        collector c;
+        startPartner([]() {
+            while (!stop) {
+                this_thread::yield();
+            }
+        }, RUNNER_PRIORITY);
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            this_thread::yield();
+            c.add(cycle_clock::now() - t0);
+        }
+        stop = true;
+        partner.join();
+        report(c.finish("yield.round_trip"));
+    }
+
+    void benchRawYield() {
+        collector c;
+        startRawPartner([](ULONG) {
+            while (!stop) {
+                tx_thread_relinquish();
+            }
+        }, RUNNER_PRIORITY);
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            tx_thread_relinquish();
+            c.add(cycle_clock::now() - t0);
+        }
+        stop = true;
+        tx_thread_relinquish();
+        deleteRawPartner();
+        report(c.finish("raw.yield.round_trip"));
+    }
+
+    void benchSuspendResume() {
+        collector c;
+        // the partner preempts the runner on every resume and suspends itself again
+        startPartner([]() {
+            while (!stop) {
+                partner.suspend();
+            }
+        }, HIGH_PRIORITY);
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            partner.resume();
+            c.add(cycle_clock::now() - t0);
+        }
+        stop = true;
+        partner.resume();
+        partner.join();
+        report(c.finish("suspend_resume.round_trip"));
+    }
+
+    void benchRawSuspendResume() {
+        collector c;
+        startRawPartner([](ULONG) {
+            while (!stop) {
+                tx_thread_suspend(&raw_partner);
+            }
+        }, HIGH_PRIORITY);
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            tx_thread_resume(&raw_partner);
+            c.add(cycle_clock::now() - t0);
+        }
+        stop = true;
+        tx_thread_resume(&raw_partner);
+        deleteRawPartner();
+        report(c.finish("raw.suspend_resume.round_trip"));
+    }
+
+    cycle_clock::duration deviation(cycle_clock::duration measured, cycle_clock::duration expected) {
+        return (measured > expected) ? measured - expected : expected - measured;
+    }
+
+    void benchSleep() {
+        const auto tick = cycle_clock::fromTickTimer(tick_timer::duration(1));
+        const auto n = std::min(iterations, MAX_SLEEP_ITERATIONS);
+
+        collector sleep_for;
+        this_thread::sleepFor(tick_timer::duration(1));
+        auto previous = cycle_clock::now();
+        for (std::uint32_t i = 0; i < n; ++i) {
+            this_thread::sleepFor(tick_timer::duration(1));
+            const auto now = cycle_clock::now();
+            sleep_for.add(deviation(now - previous, tick));
+            previous = now;
+        }
+        report(sleep_for.finish("sleep_for.jitter"));
+
+        collector sleep_until;
+        auto deadline = tick_timer::now() + tick_timer::duration(1);
+        this_thread::sleepUntil(deadline);
+        previous = cycle_clock::now();
+        for (std::uint32_t i = 0; i < n; ++i) {
+            deadline += tick_timer::duration(1);
+            this_thread::sleepUntil(deadline);
+            const auto now = cycle_clock::now();
+            sleep_until.add(deviation(now - previous, tick));
+            previous = now;
+        }
+        report(sleep_until.finish("sleep_until.jitter"));
+    }
+
+    void benchCreateDestroy() {
+        using bench_thread = static_thread<STACK_SIZE>;
+        alignas(bench_thread) static unsigned char storage[sizeof(bench_thread)];
+        collector create;
+        collector destroy;
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            auto *t = new(storage) bench_thread(&emptyEntry, ULONG{0}, LOW_PRIORITY, "bench create");
+            const auto t0 = cycle_clock::now();
+            t->createThread();
+            const auto t1 = cycle_clock::now();
+            t->~bench_thread();
+            const auto t2 = cycle_clock::now();
+            create.add(t1 - t0);
+            destroy.add(t2 - t1);
+        }
+        report(create.finish("create_thread"));
+        report(destroy.finish("destroy_thread"));
+    }
+
+    void benchRawCreateDelete() {
+        collector create;
+        collector destroy;
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            tx_thread_create(&raw_partner, const_cast<char *>("bench raw"), &emptyEntry, 0, raw_stack,
+                             sizeof(raw_stack), LOW_PRIORITY, LOW_PRIORITY, TX_NO_TIME_SLICE, TX_DONT_START);
+            const auto t1 = cycle_clock::now();
+            tx_thread_terminate(&raw_partner);
+            tx_thread_delete(&raw_partner);
+            const auto t2 = cycle_clock::now();
+            create.add(t1 - t0);
+            destroy.add(t2 - t1);
+        }
+        report(create.finish("raw.create_thread"));
+        report(destroy.finish("raw.destroy_thread"));
+    }
+
+    void benchJoin() {
+        collector c;
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            // the partner runs as soon as the runner waits in join()
+            startPartner([]() { stamp = cycle_clock::now().time_since_epoch().count(); }, LOW_PRIORITY);
+            partner.join();
+            const auto t1 = cycle_clock::now();
+            c.add(t1 - cycle_clock::time_point(cycle_clock::duration(stamp)));
+        }
+        report(c.finish("join.latency"));
+    }
+
+    void benchSemaphore() {
+        collector c;
+        semaphore sem(0, semaphore::max(), "bench");
+        sem.createSemaphore();
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            sem.release();
+            sem.try_acquire();
+            c.add(cycle_clock::now() - t0);
+        }
+        report(c.finish("semaphore.release_acquire"));
+    }
+
+    void benchRawSemaphore() {
+        collector c;
+        TX_SEMAPHORE sem;
+        tx_semaphore_create(&sem, const_cast<char *>("bench raw"), 0);
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            tx_semaphore_put(&sem);
+            tx_semaphore_get(&sem, TX_NO_WAIT);
+            c.add(cycle_clock::now() - t0);
+        }
+        tx_semaphore_delete(&sem);
+        report(c.finish("raw.semaphore.release_acquire"));
+    }
+
+    void benchQueue() {
+        collector c;
+        static_queue<ULONG, 4> q("bench");
+        q.createQueue();
+        ULONG item = 0;
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            q.trySend(item);
+            q.tryReceive(item);
+            c.add(cycle_clock::now() - t0);
+        }
+        report(c.finish("queue.send_receive"));
+    }
+
+    void benchRawQueue() {
+        collector c;
+        TX_QUEUE q;
+        ULONG storage[4];
+        tx_queue_create(&q, const_cast<char *>("bench raw"), TX_1_ULONG, storage, sizeof(storage));
+        ULONG item = 0;
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            tx_queue_send(&q, &item, TX_NO_WAIT);
+            tx_queue_receive(&q, &item, TX_NO_WAIT);
+            c.add(cycle_clock::now() - t0);
+        }
+        tx_queue_delete(&q);
+        report(c.finish("raw.queue.send_receive"));
+    }
+
+    void benchMutex() {
+        collector c;
+        mutex m(true, "bench");
+        m.createMutex();
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            m.lock();
+            m.unlock();
+            c.add(cycle_clock::now() - t0);
+        }
+        report(c.finish("mutex.lock_unlock"));
+    }
+
+    void benchRawMutex() {
+        collector c;
+        TX_MUTEX m;
+        tx_mutex_create(&m, const_cast<char *>("bench raw"), TX_INHERIT);
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            tx_mutex_get(&m, TX_WAIT_FOREVER);
+            tx_mutex_put(&m);
+            c.add(cycle_clock::now() - t0);
+        }
+        tx_mutex_delete(&m);
+        report(c.finish("raw.mutex.lock_unlock"));
+    }
+
+    void benchEventFlags() {
+        collector c;
+        event_flags flags("bench");
+        flags.createEventFlags();
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            flags.set(1);
+            flags.waitAnyFor(1, tick_timer::duration::zero());
+            c.add(cycle_clock::now() - t0);
+        }
+        report(c.finish("event_flags.set_wait"));
+    }
+
+    void benchRawEventFlags() {
+        collector c;
+        TX_EVENT_FLAGS_GROUP flags;
+        tx_event_flags_create(&flags, const_cast<char *>("bench raw"));
+        ULONG actual;
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            tx_event_flags_set(&flags, 1, TX_OR);
+            tx_event_flags_get(&flags, 1, TX_OR_CLEAR, &actual, TX_NO_WAIT);
+            c.add(cycle_clock::now() - t0);
+        }
+        tx_event_flags_delete(&flags);
+        report(c.finish("raw.event_flags.set_wait"));
+    }
+
+    void benchNotify() {
+        collector c;
+        for (std::uint32_t i = 0; i < iterations; ++i) {
+            const auto t0 = cycle_clock::now();
+            runner.notify(1);
+            this_thread::notifyWaitFor(tick_timer::duration::zero(), 1);
+            c.add(cycle_clock::now() - t0);
+        }
+        report(c.finish("notify.notify_wait"));
+    }
+
+    void runnerEntry(ULONG) {
+        if (groups & bench::scheduling) {
+            benchYield();
+            benchRawYield();
+            benchSuspendResume();
+            benchRawSuspendResume();
+        }
+        if (groups & bench::sleep) {
+            benchSleep();
+        }
+        if (groups & bench::lifecycle) {
+            benchCreateDestroy();
+            benchRawCreateDelete();
+            benchJoin();
+        }
+        if (groups & bench::primitives) {
+            benchSemaphore();
+            benchRawSemaphore();
+            benchQueue();
+            benchRawQueue();
+            benchMutex();
+            benchRawMutex();
+            benchEventFlags();
+            benchRawEventFlags();
+            benchNotify();
+        }
+        if (done != nullptr) {
+            done();
+        }
+    }
+}
+
+void bench::start(report_fn report_result, done_fn done_all, std::uint32_t n, std::uint32_t selected) {
+    assert(report_result != nullptr);
+    report = report_result;
+    done = done_all;
+    iterations = n;
+    groups = selected;
+    cycle_clock::init();
+    partner.createThread();
+    runner.createThread();
+    runner.resume();
+}
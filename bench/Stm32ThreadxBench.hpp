@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXBENCH_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXBENCH_HPP
+
+#include <cstdint>
+
+/**
+ * @brief Priority of the benchmark runner, the helper threads run one level above and below.
+ */
+#ifndef STM32THREADXTHREAD_BENCH_PRIORITY
+#define STM32THREADXTHREAD_BENCH_PRIORITY 10
+#endif
+
+namespace Stm32ThreadxThread::bench {
+    /**
+     * @struct result
+     * @brief Result of one benchmark, in `cycle_clock` cycles.
+     */
+    struct result {
+        const char *name; ///< Name of the benchmark, prefixed with `raw.` for the plain tx_* reference
+        std::uint32_t samples; ///< Number of measurements
+        std::uint32_t min; ///< Shortest measurement
+        std::uint32_t max; ///< Longest measurement
+        std::uint32_t mean; ///< Arithmetic mean of all measurements
+    };
+
+    /**
+     * @brief Groups of benchmarks, to run a subset.
+     */
+    enum group : std::uint32_t {
+        scheduling = 1UL << 0, ///< yield and suspend/resume round trips
+        sleep = 1UL << 1, ///< wake-up jitter of sleepFor() and sleepUntil()
+        lifecycle = 1UL << 2, ///< thread create, destroy and join
+        primitives = 1UL << 3, ///< semaphore, queue, mutex, event flags and notifications
+        all = 0xFUL,
+    };
+
+    using report_fn = void (*)(const result &r);
+    using done_fn = void (*)();
+
+    /**
+     * @brief Creates the benchmark threads and starts the runner.
+     *
+     * Call from `tx_application_define()`. The runner measures
+     * - `this_thread::yield()` ping-pong between two threads of the same priority,
+     * - the round trip of `resume()` to a higher priority thread suspending itself again,
+     * - the wake-up jitter of `sleepFor()` and `sleepUntil()` against the tick period,
+     * - `createThread()` and `~thread()`,
+     * - the latency from the end of a thread's entry function to `join()` returning,
+     * - uncontended round trips of semaphore, queue, mutex, event flags and thread notifications,
+     *
+     * and where possible the same with plain tx_* calls. Every result is passed to `report`, `done` is called
+     * when all benchmarks have finished.
+     *
+     * @param report Called from the runner thread for every result.
+     * @param done Called from the runner thread at the end, may be nullptr.
+     * @param iterations Number of measurements per benchmark, the sleep benchmarks use at most 100.
+     * @param groups The groups of benchmarks to run, a combination of `group` values.
+     */
+    void start(report_fn report, done_fn done = nullptr, std::uint32_t iterations = 1000,
+               std::uint32_t groups = all);
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXBENCH_HPP
@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+/*
+ * ThreadX application running the benchmarks and printing the results.
+ * Retarget printf() to a UART or the ITM on the board.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "tx_api.h"
+#include "Stm32ThreadxBench.hpp"
+
+namespace {
+    std::uint32_t iterations = 1000;
+    std::uint32_t groups = Stm32ThreadxThread::bench::all;
+    std::uint32_t failures = 0;
+
+    std::uint32_t parseGroup(const char *name) {
+        using namespace Stm32ThreadxThread;
+        constexpr struct {
+            const char *name;
+            std::uint32_t group;
+        } names[] = {
+            {"scheduling", bench::scheduling},
+            {"sleep", bench::sleep},
+            {"lifecycle", bench::lifecycle},
+            {"primitives", bench::primitives},
+            {"all", bench::all},
+        };
+        for (const auto &n: names) {
+            if (std::strcmp(n.name, name) == 0) {
+                return n.group;
+            }
+        }
+        return 0;
+    }
+
+    void printResult(const Stm32ThreadxThread::bench::result &r) {
+        // a benchmark without a single measurement is broken, not fast
+        if (r.samples == 0) {
+            ++failures;
+        }
+        std::printf("%-32s n=%-6lu min=%-8lu mean=%-8lu max=%lu\n", r.name,
+                    static_cast<unsigned long>(r.samples), static_cast<unsigned long>(r.min),
+                    static_cast<unsigned long>(r.mean), static_cast<unsigned long>(r.max));
+    }
+
+    void finish() {
+        std::fflush(stdout);
+#ifndef __arm__
+        std::exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+#endif
+    }
+}
+
+extern "C" void tx_application_define(void *) {
+    Stm32ThreadxThread::bench::start(&printResult, &finish, iterations, groups);
+}
+
+int main(int argc, char *argv[]) {
+    // on the host: bench [iterations [scheduling|sleep|lifecycle|primitives|all]], e.g. for profiling with perf
+    if (argc > 1) {
+        iterations = static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+    if (argc > 2) {
+        groups = parseGroup(argv[2]);
+        if (groups == 0) {
+            std::fprintf(stderr, "unknown benchmark group: %s\n", argv[2]);
+            return EXIT_FAILURE;
+        }
+    }
+    tx_kernel_enter();
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXARENA_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace Stm32ThreadxThread {
+    /**
+     * @class arena
+     * @brief Bump allocator over a fixed buffer.
+     *
+     * Allocation only advances a pointer, memory is given back all at once by `reset()`, e.g. after each
+     * processed message. Destructors of objects created in the arena are not called by `reset()`.
+     *
+     * @note An arena is not synchronized, it is meant to be used by a single thread.
+     *
+     * @see static_thread, this_thread::arena()
+     */
+    class arena {
+    public:
+        arena(void *buffer, std::size_t size)
+            : begin(static_cast<unsigned char *>(buffer)), end(begin + size), current(begin) {
+        }
+
+        arena(const arena &) = delete;
+
+        arena &operator=(const arena &) = delete;
+
+        /**
+         * @brief Allocates memory from the arena.
+         *
+         * @param size The number of bytes.
+         * @param alignment The alignment, a power of two.
+         * @return The memory, nullptr if the arena is exhausted.
+         */
+        void *allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+            const auto address = reinterpret_cast<std::uintptr_t>(current);
+            const auto aligned = (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+            const auto padding = aligned - address;
+            if (padding + size > static_cast<std::size_t>(end - current)) {
+                return nullptr;
+            }
+            current += padding + size;
+            if (current - begin > static_cast<std::ptrdiff_t>(peak)) {
+                peak = current - begin;
+            }
+            return reinterpret_cast<void *>(aligned);
+        }
+
+        /**
+         * @brief Constructs an object in the arena.
+         * @return The object, nullptr if the arena is exhausted.
+         */
+        template<class T, class... Args>
+        T *make(Args &&... args) {
+            void *p = allocate(sizeof(T), alignof(T));
+            return (p != nullptr) ? new(p) T(std::forward<Args>(args)...) : nullptr;
+        }
+
+        /**
+         * @brief Gives back all memory allocated from the arena.
+         */
+        void reset() {
+            current = begin;
+        }
+
+        [[nodiscard]] std::size_t getCapacity() const {
+            return end - begin;
+        }
+
+        [[nodiscard]] std::size_t getUsed() const {
+            return current - begin;
+        }
+
+        [[nodiscard]] std::size_t getAvailable() const {
+            return end - current;
+        }
+
+        /**
+         * @brief Get the highest usage since construction.
+         */
+        [[nodiscard]] std::size_t getPeak() const {
+            return peak;
+        }
+
+    private:
+        unsigned char *begin;
+        unsigned char *end;
+        unsigned char *current;
+        std::size_t peak{};
+    };
+
+    namespace detail {
+        template<std::size_t SIZE>
+        class thread_arena {
+        protected:
+            arena *threadArena() {
+                return &arena_;
+            }
+
+        private:
+            alignas(std::max_align_t) unsigned char storage_[SIZE];
+            arena arena_{storage_, SIZE};
+        };
+
+        template<>
+        class thread_arena<0> {
+        protected:
+            static arena *threadArena() {
+                return nullptr;
+            }
+        };
+    }
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXARENA_HPP
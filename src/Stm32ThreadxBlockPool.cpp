@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include <cassert>
+#include "Stm32ThreadxBlockPool.hpp"
+#include "Stm32ThreadxConfig.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+void block_pool::createBlockPool() {
+    // https://github.com/eclipse-threadx/rtos-docs/blob/main/rtos-docs/threadx/chapter4.md#tx_block_pool_create
+    STM32THREADXTHREAD_ASSERT(storage != nullptr);
+    STM32THREADXTHREAD_ASSERT(block_size > 0);
+    auto result = tx_block_pool_create(
+        this, // TX_BLOCK_POOL *pool_ptr
+        const_cast<char *>(name), // CHAR *name_ptr
+        block_size, // ULONG block_size
+        storage, // VOID *pool_start
+        storage_size); // ULONG pool_size
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+block_pool::~block_pool() {
+    if (!isCreated()) {
+        return;
+    }
+    auto result = tx_block_pool_delete(this);
+    assert(result == TX_SUCCESS);
+    (void) result;
+}
+
+bool block_pool::isCreated() const {
+    return tx_block_pool_id == TX_BLOCK_POOL_ID;
+}
@@ -0,0 +1,290 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXBLOCKPOOL_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXBLOCKPOOL_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "tx_api.h"
+#include "Stm32ThreadxTickTimer.hpp"
+
+namespace Stm32ThreadxThread {
+    namespace native {
+        using ULONG = ULONG;
+        using ALIGN_TYPE = ALIGN_TYPE;
+        using TX_BLOCK_POOL = TX_BLOCK_POOL;
+    }
+
+    /**
+     * @class block_pool
+     * @brief Wraps a ThreadX block pool of fixed-size memory blocks.
+     *
+     * Allocation and release are O(1) and never fragment the pool.
+     *
+     * @note The pool must be created by calling `createBlockPool()` before it is used.
+     *
+     * @see static_block_pool
+     */
+    class block_pool : private native::TX_BLOCK_POOL {
+    public:
+        ~block_pool();
+
+        /**
+         * @brief Create the block pool by calling `tx_block_pool_create()`.
+         */
+        void createBlockPool();
+
+        /**
+         * @brief Allocates a block, blocks until a block is available or the timeout expires.
+         * @param rel_time The maximum duration to wait.
+         * @return Pointer to the block, nullptr if no block is available.
+         * @remark Thread context callable, ISR context callable with `rel_time` zero
+         */
+        void *allocateBlock(tick_timer::duration rel_time) {
+            void *block = nullptr;
+            if (tx_block_allocate(this, &block, toTicks(rel_time)) != TX_SUCCESS) {
+                return nullptr;
+            }
+            return block;
+        }
+
+        /**
+         * @brief Releases a block back to the pool it was allocated from.
+         *
+         * The pool is found through the block's header, so the pool itself isn't needed.
+         *
+         * @param block Pointer to the block.
+         * @remark Thread and ISR context callable
+         */
+        static void releaseBlock(void *block) {
+            tx_block_release(block);
+        }
+
+        /**
+         * @brief Get the number of available blocks.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] native::ULONG getAvailable() const {
+            return tx_block_pool_available;
+        }
+
+        /**
+         * @brief Get the total number of blocks.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] native::ULONG getTotal() const {
+            return tx_block_pool_total;
+        }
+
+    protected:
+        static constexpr const char *DEFAULT_NAME = "N/A";
+
+        block_pool(void *storage, native::ULONG storage_size, native::ULONG block_size, const char *name)
+            : TX_BLOCK_POOL(), storage(storage), storage_size(storage_size), block_size(block_size), name(name) {
+        }
+
+    private:
+        block_pool(const block_pool &) = delete;
+
+        block_pool &operator=(const block_pool &) = delete;
+
+        [[nodiscard]] bool isCreated() const;
+
+        void *storage{};
+        native::ULONG storage_size{};
+        native::ULONG block_size{};
+        const char *name{};
+    };
+
+
+    /**
+     * @class pool_ptr
+     * @brief Owning pointer to an object living in a block pool block.
+     *
+     * On destruction the object is destroyed and the block is released to its pool.
+     * The raw pointer can be passed on, e.g. through a `static_queue<T *, N>`, with `release()`
+     * and adopted on the other side with `pool_ptr(T *)`.
+     *
+     * @tparam T The type of the object.
+     */
+    template<class T>
+    class pool_ptr {
+    public:
+        constexpr pool_ptr() noexcept = default;
+
+        constexpr pool_ptr(std::nullptr_t) noexcept {
+        }
+
+        explicit pool_ptr(T *ptr) noexcept
+            : ptr(ptr) {
+        }
+
+        pool_ptr(pool_ptr &&other) noexcept
+            : ptr(other.release()) {
+        }
+
+        pool_ptr &operator=(pool_ptr &&other) noexcept {
+            reset(other.release());
+            return *this;
+        }
+
+        pool_ptr(const pool_ptr &) = delete;
+
+        pool_ptr &operator=(const pool_ptr &) = delete;
+
+        ~pool_ptr() {
+            reset();
+        }
+
+        [[nodiscard]] T *get() const noexcept {
+            return ptr;
+        }
+
+        T &operator*() const noexcept {
+            return *ptr;
+        }
+
+        T *operator->() const noexcept {
+            return ptr;
+        }
+
+        explicit operator bool() const noexcept {
+            return ptr != nullptr;
+        }
+
+        /**
+         * @brief Gives up ownership of the object without destroying it.
+         * @return Pointer to the object.
+         */
+        T *release() noexcept {
+            T *old = ptr;
+            ptr = nullptr;
+            return old;
+        }
+
+        /**
+         * @brief Destroys the owned object, if any, and takes ownership of another one.
+         * @param other Pointer to the new object, must be allocated from a block pool.
+         */
+        void reset(T *other = nullptr) noexcept {
+            T *old = ptr;
+            ptr = other;
+            if (old != nullptr) {
+                old->~T();
+                block_pool::releaseBlock(old);
+            }
+        }
+
+    private:
+        T *ptr{};
+    };
+
+
+    /**
+     * @class static_block_pool
+     * @brief Typed block pool with statically allocated storage for `N` objects of type `T`.
+     *
+     * The storage is laid out so that each block, which is preceded by the kernel's block header,
+     * is correctly aligned for `T`.
+     *
+     * @tparam T The type of the objects.
+     * @tparam N The number of blocks.
+     */
+    template<class T, std::size_t N>
+    class static_block_pool : public block_pool {
+        static_assert(N > 0, "N must be greater than zero");
+
+        static constexpr std::size_t max(std::size_t a, std::size_t b) {
+            return a > b ? a : b;
+        }
+
+        static constexpr std::size_t HEADER_SIZE = sizeof(void *);
+        static constexpr std::size_t ALIGNMENT = max(alignof(T), max(HEADER_SIZE, sizeof(native::ALIGN_TYPE)));
+        static constexpr std::size_t BLOCK_SIZE =
+                (sizeof(T) + HEADER_SIZE + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT - HEADER_SIZE;
+        static constexpr std::size_t PADDING = ALIGNMENT - HEADER_SIZE;
+
+    public:
+        using value_type = T;
+        static constexpr std::size_t CAPACITY = N;
+
+        explicit static_block_pool(const char *name = DEFAULT_NAME)
+            : block_pool(storage_ + PADDING, sizeof(storage_) - PADDING, BLOCK_SIZE, name) {
+        }
+
+        /**
+         * @brief Allocates uninitialized memory for one `T`.
+         * @param rel_time The maximum duration to wait for a free block.
+         * @return Pointer to the memory, nullptr if no block is available.
+         * @remark Thread context callable, ISR context callable with `rel_time` zero
+         */
+        T *allocate(tick_timer::duration rel_time) {
+            return static_cast<T *>(allocateBlock(rel_time));
+        }
+
+        /**
+         * @brief Allocates uninitialized memory for one `T` without blocking.
+         * @remark Thread and ISR context callable
+         */
+        T *tryAllocate() {
+            return allocate(tick_timer::duration::zero());
+        }
+
+        /**
+         * @brief Releases memory allocated by `allocate()`, without destroying an object.
+         * @remark Thread and ISR context callable
+         */
+        static void deallocate(T *ptr) {
+            releaseBlock(ptr);
+        }
+
+        /**
+         * @brief Allocates a block and constructs a `T` in it.
+         * @param rel_time The maximum duration to wait for a free block.
+         * @param args The constructor arguments.
+         * @return Owning pointer to the object, empty if no block is available.
+         * @remark Thread context callable, ISR context callable with `rel_time` zero
+         */
+        template<class... Args>
+        pool_ptr<T> makeFor(tick_timer::duration rel_time, Args &&... args) {
+            void *block = allocateBlock(rel_time);
+            if (block == nullptr) {
+                return pool_ptr<T>();
+            }
+            return pool_ptr<T>(::new(block) T(std::forward<Args>(args)...));
+        }
+
+        /**
+         * @brief Allocates a block and constructs a `T` in it, blocks until a block is available.
+         * @remark Thread context callable
+         */
+        template<class... Args>
+        pool_ptr<T> make(Args &&... args) {
+            return makeFor(infinity, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Destroys an object created by `make()` and released from its `pool_ptr`.
+         * @remark Thread and ISR context callable
+         */
+        static void destroy(T *ptr) {
+            pool_ptr<T>(ptr).reset();
+        }
+
+    private:
+        alignas(ALIGNMENT) unsigned char storage_[PADDING + N * (BLOCK_SIZE + HEADER_SIZE)]{};
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXBLOCKPOOL_HPP
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include <cassert>
+#include "Stm32ThreadxBytePool.hpp"
+#include "Stm32ThreadxConfig.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+void byte_pool::createBytePool() {
+    // https://github.com/eclipse-threadx/rtos-docs/blob/main/rtos-docs/threadx/chapter4.md#tx_byte_pool_create
+    STM32THREADXTHREAD_ASSERT(storage != nullptr);
+    STM32THREADXTHREAD_ASSERT(storage_size > 0);
+    auto result = tx_byte_pool_create(
+        this, // TX_BYTE_POOL *pool_ptr
+        const_cast<char *>(name), // CHAR *name_ptr
+        storage, // VOID *pool_start
+        storage_size); // ULONG pool_size
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+byte_pool::~byte_pool() {
+    if (!isCreated()) {
+        return;
+    }
+    auto result = tx_byte_pool_delete(this);
+    assert(result == TX_SUCCESS);
+    (void) result;
+}
+
+bool byte_pool::isCreated() const {
+    return tx_byte_pool_id == TX_BYTE_POOL_ID;
+}
@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXBYTEPOOL_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXBYTEPOOL_HPP
+
+#include <cstddef>
+#include "tx_api.h"
+#include "Stm32ThreadxTickTimer.hpp"
+
+namespace Stm32ThreadxThread {
+    namespace native {
+        using ULONG = ULONG;
+        using ALIGN_TYPE = ALIGN_TYPE;
+        using TX_BYTE_POOL = TX_BYTE_POOL;
+    }
+
+    /**
+     * @class byte_pool
+     * @brief Wraps a ThreadX byte pool of variable-size memory blocks.
+     *
+     * Unlike a `block_pool`, allocations of any size are possible, at the cost of a first-fit search and
+     * fragmentation. Memory is aligned to `native::ALIGN_TYPE`.
+     *
+     * @note The pool must be created by calling `createBytePool()` before it is used.
+     *
+     * @see static_byte_pool, dynamic_thread
+     */
+    class byte_pool : private native::TX_BYTE_POOL {
+    public:
+        ~byte_pool();
+
+        /**
+         * @brief Create the byte pool by calling `tx_byte_pool_create()`.
+         */
+        void createBytePool();
+
+        /**
+         * @brief Allocates memory, blocks until enough memory is available or the timeout expires.
+         * @param size The number of bytes.
+         * @param rel_time The maximum duration to wait.
+         * @return Pointer to the memory, nullptr if not enough memory is available.
+         * @remark Thread context callable
+         */
+        void *allocate(std::size_t size, tick_timer::duration rel_time) {
+            void *memory = nullptr;
+            if (tx_byte_allocate(this, &memory, static_cast<native::ULONG>(size), toTicks(rel_time)) != TX_SUCCESS) {
+                return nullptr;
+            }
+            return memory;
+        }
+
+        /**
+         * @brief Releases memory back to the pool it was allocated from.
+         *
+         * The pool is found through the memory's header, so the pool itself isn't needed.
+         *
+         * @param memory Pointer to the memory.
+         * @remark Thread context callable
+         */
+        static void release(void *memory) {
+            tx_byte_release(memory);
+        }
+
+        /**
+         * @brief Get the number of available bytes, which may be fragmented.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] native::ULONG getAvailable() const {
+            return tx_byte_pool_available;
+        }
+
+    protected:
+        static constexpr const char *DEFAULT_NAME = "N/A";
+
+        byte_pool(void *storage, native::ULONG storage_size, const char *name)
+            : TX_BYTE_POOL(), storage(storage), storage_size(storage_size), name(name) {
+        }
+
+    private:
+        byte_pool(const byte_pool &) = delete;
+
+        byte_pool &operator=(const byte_pool &) = delete;
+
+        [[nodiscard]] bool isCreated() const;
+
+        void *storage{};
+        native::ULONG storage_size{};
+        const char *name{};
+    };
+
+
+    /**
+     * @class static_byte_pool
+     * @brief Byte pool with statically allocated storage.
+     *
+     * The kernel uses part of the storage for its block headers, so less than `SIZE_BYTES` can be allocated.
+     *
+     * @tparam SIZE_BYTES The size of the storage in bytes.
+     */
+    template<std::size_t SIZE_BYTES>
+    class static_byte_pool : public byte_pool {
+        static_assert(SIZE_BYTES >= 100, "SIZE_BYTES must be at least 100 bytes");
+
+    public:
+        static constexpr std::size_t SIZE = SIZE_BYTES;
+
+        explicit static_byte_pool(const char *name = DEFAULT_NAME)
+            : byte_pool(storage_, sizeof(storage_), name) {
+        }
+
+    private:
+        alignas(native::ALIGN_TYPE) unsigned char storage_[SIZE_BYTES]{};
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXBYTEPOOL_HPP
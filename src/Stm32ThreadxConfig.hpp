@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXCONFIG_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXCONFIG_HPP
+
+/**
+ * @brief Checks arguments and results of kernel calls in the library's translation units.
+ *
+ * Defaults to `assert_param()` of the STM32 HAL if the project provides `main.hpp`, and to `assert()`
+ * otherwise, e.g. on the ThreadX Linux port. Define it in the compiler flags to route failures to an own
+ * handler:
+ *
+ * @code
+ * -D'STM32THREADXTHREAD_ASSERT(expr)=((expr) ? (void)0 : onAssert(__FILE__, __LINE__))'
+ * @endcode
+ */
+#ifndef STM32THREADXTHREAD_ASSERT
+#if __has_include("main.hpp")
+#include "main.hpp"
+#define STM32THREADXTHREAD_ASSERT(expr) assert_param(expr)
+#else
+#include <cassert>
+#define STM32THREADXTHREAD_ASSERT(expr) assert(expr)
+#endif
+#endif
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXCONFIG_HPP
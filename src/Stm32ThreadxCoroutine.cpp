@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+#include "Stm32ThreadxCoroutine.hpp"
+
+#if defined(__cpp_impl_coroutine) && !defined(TX_DISABLE_NOTIFY_CALLBACKS)
+
+#include <algorithm>
+#include <limits>
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::co;
+
+bool scheduler_base::spawn(task &&t) {
+    if (!t) {
+        return false;
+    }
+    t.h.promise().sched = this;
+    if (!post(t.h)) {
+        return false;
+    }
+    t.h = nullptr;
+    return true;
+}
+
+void scheduler_base::kick(void *self) {
+    auto *s = static_cast<scheduler_base *>(self);
+    if (s->kick_pending.exchange(true)) {
+        // a wakeup is queued already and polls all waiters
+        return;
+    }
+    if (!s->post_fn(*s, s)) {
+        // a full ready queue wakes the scheduler anyway
+        s->kick_pending.store(false);
+    }
+}
+
+void scheduler_base::addSleeper(sleep_node &node) {
+    node.next = sleepers;
+    sleepers = &node;
+}
+
+void scheduler_base::addWaiter(wait_node &node) {
+    node.next = nullptr;
+    if (waiters_tail != nullptr) {
+        waiters_tail->next = &node;
+    } else {
+        waiters = &node;
+    }
+    waiters_tail = &node;
+}
+
+void scheduler_base::step(void *address) {
+    if (address == this) {
+        // before polling, a kick during the poll queues a new wakeup
+        kick_pending.store(false);
+    } else if (address != nullptr) {
+        resume(std::coroutine_handle<>::from_address(address));
+    }
+    wakeSleepers();
+    pollWaiters();
+}
+
+tick_timer::duration scheduler_base::nextTimeout() const {
+    if (sleepers == nullptr) {
+        return infinity;
+    }
+    auto next = sleepers->deadline;
+    for (auto *n = sleepers->next; n != nullptr; n = n->next) {
+        next = std::min(next, n->deadline);
+    }
+    const auto remaining = (next - tick_timer64::now()).count();
+    if (remaining <= 0) {
+        return tick_timer::duration::zero();
+    }
+    constexpr auto max_wait = static_cast<tick_timer64::rep>(std::numeric_limits<tick_timer::rep>::max() - 1);
+    return tick_timer::duration(static_cast<tick_timer::rep>(std::min(remaining, max_wait)));
+}
+
+void scheduler_base::resume(std::coroutine_handle<> h) {
+    h.resume();
+    if (h.done()) {
+        h.destroy();
+    }
+}
+
+void scheduler_base::wakeSleepers() {
+    const auto now = tick_timer64::now();
+    sleep_node *due = nullptr;
+    for (auto **link = &sleepers; *link != nullptr;) {
+        auto *n = *link;
+        if (n->deadline <= now) {
+            *link = n->next;
+            n->next = due;
+            due = n;
+        } else {
+            link = &n->next;
+        }
+    }
+    // the resumed coroutines may add new sleepers, so they are resumed after unlinking
+    while (due != nullptr) {
+        auto *n = due;
+        due = n->next;
+        resume(n->h);
+    }
+}
+
+void scheduler_base::pollWaiters() {
+    // a resumed coroutine may have sent or released what an already polled waiter waits for,
+    // so poll again until a pass resumes nothing
+    bool resumed;
+    do {
+        resumed = false;
+        auto *pending = waiters;
+        waiters = nullptr;
+        waiters_tail = nullptr;
+        while (pending != nullptr) {
+            auto *n = pending;
+            pending = n->next;
+            if (n->tryComplete(*n)) {
+                resume(n->h);
+                resumed = true;
+            } else {
+                addWaiter(*n);
+            }
+        }
+    } while (resumed);
+}
+
+#endif // __cpp_impl_coroutine && !TX_DISABLE_NOTIFY_CALLBACKS
@@ -0,0 +1,495 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXCOROUTINE_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXCOROUTINE_HPP
+
+#if defined(__cpp_impl_coroutine) && !defined(TX_DISABLE_NOTIFY_CALLBACKS)
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+#include "Stm32ThreadxThread.hpp"
+#include "Stm32ThreadxQueue.hpp"
+#include "Stm32ThreadxSemaphore.hpp"
+#include "Stm32ThreadxBlockPool.hpp"
+
+/**
+ * Coroutines multiplexed on a single scheduler thread, for many state machines that would otherwise each need
+ * their own thread and stack.
+ *
+ * @code
+ * co::static_frame_pool<256, 40> frames;
+ * co::scheduler<2048> gateway(5, "gateway");
+ * static_queue<frame, 16> rx;
+ *
+ * co::task protocol() {
+ *     for (;;) {
+ *         frame f = co_await co::receive(rx);
+ *         co_await co::sleepFor(std::chrono::milliseconds(10));
+ *     }
+ * }
+ *
+ * void tx_application_define(void *) {
+ *     frames.createFramePool();
+ *     rx.createQueue();
+ *     gateway.createScheduler();
+ *     gateway.spawn(protocol());
+ * }
+ * @endcode
+ *
+ * @note Requires C++20 coroutines and the notify callbacks of the kernel.
+ */
+namespace Stm32ThreadxThread::co {
+    class scheduler_base;
+
+    namespace detail {
+        struct frame_allocator {
+            block_pool *pool;
+            std::size_t block_size;
+        };
+
+        inline frame_allocator frames{};
+
+        inline void *allocateFrame(std::size_t size) noexcept {
+            if (frames.pool == nullptr || size > frames.block_size) {
+                return nullptr;
+            }
+            return frames.pool->allocateBlock(tick_timer::duration::zero());
+        }
+
+        inline void releaseFrame(void *frame) noexcept {
+            block_pool::releaseBlock(frame);
+        }
+    }
+
+    /**
+     * @class static_frame_pool
+     * @brief Block pool providing the frames of all coroutine tasks.
+     *
+     * A task whose frame is larger than `FRAME_SIZE_BYTES`, or created while the pool is exhausted, is empty.
+     *
+     * @tparam FRAME_SIZE_BYTES The maximum size of a coroutine frame in bytes.
+     * @tparam N The number of frames.
+     */
+    template<std::size_t FRAME_SIZE_BYTES, std::size_t N>
+    class static_frame_pool {
+        struct frame {
+            alignas(std::max_align_t) unsigned char data[FRAME_SIZE_BYTES];
+        };
+
+    public:
+        explicit static_frame_pool(const char *name = "co frames") : pool(name) {
+        }
+
+        /**
+         * @brief Creates the block pool and makes it the source of all coroutine frames.
+         */
+        void createFramePool() {
+            pool.createBlockPool();
+            detail::frames = {&pool, FRAME_SIZE_BYTES};
+        }
+
+        /**
+         * @brief Get the number of free frames.
+         */
+        [[nodiscard]] native::ULONG getAvailable() const {
+            return pool.getAvailable();
+        }
+
+    private:
+        static_block_pool<frame, N> pool;
+    };
+
+    /**
+     * @class task
+     * @brief Return type of a coroutine run by a `scheduler`.
+     *
+     * The coroutine starts suspended and runs when the task is passed to `scheduler::spawn()`, which takes over
+     * the frame. The frame is released when the coroutine finishes.
+     */
+    class task {
+    public:
+        struct promise_type {
+            scheduler_base *sched{};
+
+            task get_return_object() noexcept {
+                return task(handle::from_promise(*this));
+            }
+
+            static task get_return_object_on_allocation_failure() noexcept {
+                return task();
+            }
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept {
+                return {};
+            }
+
+            void return_void() noexcept {
+            }
+
+            void unhandled_exception() noexcept {
+                std::terminate();
+            }
+
+            static void *operator new(std::size_t size) noexcept {
+                return detail::allocateFrame(size);
+            }
+
+            static void operator delete(void *frame) noexcept {
+                detail::releaseFrame(frame);
+            }
+        };
+
+        using handle = std::coroutine_handle<promise_type>;
+
+        task() = default;
+
+        task(task &&other) noexcept : h(std::exchange(other.h, nullptr)) {
+        }
+
+        task &operator=(task &&other) noexcept {
+            if (this != &other) {
+                reset();
+                h = std::exchange(other.h, nullptr);
+            }
+            return *this;
+        }
+
+        ~task() {
+            reset();
+        }
+
+        /**
+         * @brief Checks if the task holds a coroutine, false if its frame could not be allocated.
+         */
+        explicit operator bool() const {
+            return static_cast<bool>(h);
+        }
+
+    private:
+        friend class scheduler_base;
+
+        explicit task(handle h) : h(h) {
+        }
+
+        void reset() {
+            if (h) {
+                h.destroy();
+                h = nullptr;
+            }
+        }
+
+        handle h{};
+    };
+
+    /**
+     * @brief Coroutine waiting for a point in time.
+     */
+    struct sleep_node {
+        tick_timer64::time_point deadline{};
+        std::coroutine_handle<> h{};
+        sleep_node *next{};
+    };
+
+    /**
+     * @brief Coroutine waiting for a kernel object, polled by the scheduler.
+     */
+    struct wait_node {
+        bool (*tryComplete)(wait_node &node){};
+        std::coroutine_handle<> h{};
+        wait_node *next{};
+    };
+
+    /**
+     * @class scheduler_base
+     * @brief Type independent part of `scheduler`.
+     */
+    class scheduler_base {
+    public:
+        scheduler_base(const scheduler_base &) = delete;
+
+        scheduler_base &operator=(const scheduler_base &) = delete;
+
+        /**
+         * @brief Hands a task over to the scheduler.
+         * @return true if the task has been queued, false if it's empty or the ready queue is full.
+         * @remark Thread and ISR context callable
+         */
+        bool spawn(task &&t);
+
+        /**
+         * @brief Wakes the scheduler to poll its waiting coroutines.
+         *
+         * Registered as notify callback of the queues and semaphores awaited by coroutines. Wakeups are
+         * coalesced, at most one is queued until the scheduler has taken it, so bursts of sends or puts
+         * don't fill the ready queue.
+         * @remark Thread and ISR context callable
+         */
+        static void kick(void *self);
+
+        void addSleeper(sleep_node &node);
+
+        void addWaiter(wait_node &node);
+
+        /**
+         * @brief Queues a coroutine to be resumed.
+         * @return false if the ready queue is full.
+         */
+        bool post(std::coroutine_handle<> h) {
+            return post_fn(*this, h.address());
+        }
+
+    protected:
+        using post_function = bool (*)(scheduler_base &s, void *address);
+
+        explicit scheduler_base(post_function post_fn) : post_fn(post_fn) {
+        }
+
+        /**
+         * @brief Resumes the posted coroutine, if any, then all coroutines whose wait is over.
+         * @param address The address of a posted coroutine handle, the scheduler itself for a wakeup, nullptr if
+         * a sleeper is due.
+         */
+        void step(void *address);
+
+        /**
+         * @brief Get the time until the next sleeping coroutine is due.
+         */
+        [[nodiscard]] tick_timer::duration nextTimeout() const;
+
+    private:
+        static void resume(std::coroutine_handle<> h);
+
+        void wakeSleepers();
+
+        void pollWaiters();
+
+        post_function post_fn;
+        std::atomic<bool> kick_pending{false};
+        sleep_node *sleepers{};
+        wait_node *waiters{};
+        wait_node *waiters_tail{};
+    };
+
+    /**
+     * @class scheduler
+     * @brief Thread running coroutine tasks.
+     *
+     * Tasks are resumed one after the other on the scheduler's thread. A task only gives up the thread at a
+     * `co_await`, so it must not call blocking functions.
+     *
+     * @tparam STACK_SIZE_BYTES The stack size of the scheduler thread, shared by all tasks.
+     * @tparam READY_DEPTH The capacity of the queue of spawned tasks and wakeups.
+     */
+    template<std::size_t STACK_SIZE_BYTES, std::size_t READY_DEPTH = 32>
+    class scheduler : public scheduler_base {
+    public:
+        explicit scheduler(thread::priority prio = thread::priority(), const char *name = "co scheduler")
+            : scheduler_base(&scheduler::postAddress), ready(name), worker([this]() { run(); }, prio, name) {
+        }
+
+        /**
+         * @brief Creates the ready queue and starts the scheduler thread.
+         */
+        void createScheduler() {
+            ready.createQueue();
+            worker.createThread();
+            worker.resume();
+        }
+
+        [[nodiscard]] thread &getThread() {
+            return worker;
+        }
+
+    private:
+        static bool postAddress(scheduler_base &s, void *address) {
+            return static_cast<scheduler &>(s).ready.trySend(address);
+        }
+
+        void run() {
+            for (;;) {
+                void *address = nullptr;
+                if (!ready.receiveFor(address, nextTimeout())) {
+                    address = nullptr;
+                }
+                step(address);
+            }
+        }
+
+        static_queue<void *, READY_DEPTH> ready;
+        static_thread<STACK_SIZE_BYTES> worker;
+    };
+
+    /**
+     * @brief Awaitable suspending the coroutine for a duration.
+     */
+    class sleep_awaiter : private sleep_node {
+    public:
+        explicit sleep_awaiter(tick_timer::duration rel_time) : rel_time(rel_time) {
+        }
+
+        [[nodiscard]] bool await_ready() const noexcept {
+            return rel_time.count() == 0;
+        }
+
+        void await_suspend(task::handle h) {
+            deadline = tick_timer64::now() + tick_timer64::duration(rel_time.count());
+            this->h = h;
+            h.promise().sched->addSleeper(*this);
+        }
+
+        void await_resume() const noexcept {
+        }
+
+    private:
+        tick_timer::duration rel_time;
+    };
+
+    /**
+     * @brief Suspends the coroutine for the given duration, `co_await co::sleepFor(d)`.
+     */
+    inline sleep_awaiter sleepFor(tick_timer::duration rel_time) {
+        return sleep_awaiter(rel_time);
+    }
+
+    template<class Rep, class Period>
+    sleep_awaiter sleepFor(const std::chrono::duration<Rep, Period> &rel_time) {
+        return sleepFor(std::chrono::ceil<tick_timer::duration>(rel_time));
+    }
+
+    /**
+     * @brief Awaitable receiving a message from a `static_queue`.
+     */
+    template<class Q>
+    class receive_awaiter : private wait_node {
+    public:
+        using value_type = typename Q::value_type;
+
+        explicit receive_awaiter(Q &q) : q(q) {
+            tryComplete = [](wait_node &node) {
+                auto &self = static_cast<receive_awaiter &>(node);
+                return self.q.tryReceive(self.value);
+            };
+        }
+
+        bool await_ready() {
+            return q.tryReceive(value);
+        }
+
+        bool await_suspend(task::handle h) {
+            q.setSendNotify(&scheduler_base::kick, h.promise().sched);
+            // a message sent before the notification was registered didn't kick the scheduler
+            if (q.tryReceive(value)) {
+                return false;
+            }
+            this->h = h;
+            h.promise().sched->addWaiter(*this);
+            return true;
+        }
+
+        value_type await_resume() const {
+            return value;
+        }
+
+    private:
+        Q &q;
+        value_type value{};
+    };
+
+    /**
+     * @brief Receives a message from the queue, `T msg = co_await co::receive(q)`.
+     *
+     * The queue's send notification is taken over by the scheduler of the awaiting coroutine.
+     */
+    template<class T, std::size_t N>
+    receive_awaiter<static_queue<T, N> > receive(static_queue<T, N> &q) {
+        return receive_awaiter<static_queue<T, N> >(q);
+    }
+
+    /**
+     * @brief Awaitable acquiring a semaphore.
+     */
+    class acquire_awaiter : private wait_node {
+    public:
+        explicit acquire_awaiter(semaphore &sem) : sem(sem) {
+            tryComplete = [](wait_node &node) {
+                return static_cast<acquire_awaiter &>(node).sem.try_acquire();
+            };
+        }
+
+        bool await_ready() {
+            return sem.try_acquire();
+        }
+
+        bool await_suspend(task::handle h) {
+            sem.setPutNotify(&scheduler_base::kick, h.promise().sched);
+            // a put before the notification was registered didn't kick the scheduler
+            if (sem.try_acquire()) {
+                return false;
+            }
+            this->h = h;
+            h.promise().sched->addWaiter(*this);
+            return true;
+        }
+
+        void await_resume() const noexcept {
+        }
+
+    private:
+        semaphore &sem;
+    };
+
+    /**
+     * @brief Acquires the semaphore, `co_await co::acquire(sem)`.
+     *
+     * The semaphore's put notification is taken over by the scheduler of the awaiting coroutine.
+     */
+    inline acquire_awaiter acquire(semaphore &sem) {
+        return acquire_awaiter(sem);
+    }
+
+    /**
+     * @brief Awaitable letting the other ready coroutines run first.
+     */
+    struct yield_awaiter {
+        [[nodiscard]] bool await_ready() const noexcept {
+            return false;
+        }
+
+        bool await_suspend(task::handle h) {
+            // continue right away if the ready queue is full
+            return h.promise().sched->post(h);
+        }
+
+        void await_resume() const noexcept {
+        }
+    };
+
+    /**
+     * @brief Lets the other ready coroutines run first, `co_await co::yield()`.
+     */
+    inline yield_awaiter yield() {
+        return {};
+    }
+}
+
+#endif // __cpp_impl_coroutine && !TX_DISABLE_NOTIFY_CALLBACKS
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXCOROUTINE_HPP
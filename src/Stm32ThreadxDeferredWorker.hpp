@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXDEFERREDWORKER_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXDEFERREDWORKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "Stm32ThreadxThread.hpp"
+#include "Stm32ThreadxEventFlags.hpp"
+#include "Stm32ThreadxInlineFunction.hpp"
+#include "Stm32ThreadxSpscRing.hpp"
+
+namespace Stm32ThreadxThread {
+    /**
+     * @class deferred_worker
+     * @brief Thread processing elements posted from an ISR through a lock-free ring.
+     *
+     * `post()` adds an element to an `spsc_ring` and sets the worker's event flag only if the worker
+     * had consumed all previous elements, so a burst of elements costs a single kernel call. The worker
+     * handles all available elements in one batch before it waits again.
+     *
+     * @code
+     * deferred_worker<can_frame, 64, 1024> canWorker([](can_frame &f) { dispatch(f); }, 3, "can");
+     * canWorker.createWorker();
+     * // in the CAN RX ISR:
+     * canWorker.post(frame);
+     * @endcode
+     *
+     * @tparam T The element type.
+     * @tparam N The capacity of the ring, must be a power of two.
+     * @tparam STACK_SIZE_BYTES The stack size of the worker thread in bytes.
+     * @tparam HANDLER_SIZE_BYTES The size of the inline buffer of the handler in bytes.
+     */
+    template<class T, std::size_t N, std::size_t STACK_SIZE_BYTES,
+        std::size_t HANDLER_SIZE_BYTES = 4 * sizeof(void *)>
+    class deferred_worker : public static_thread<STACK_SIZE_BYTES> {
+        static constexpr event_flags::flag_type WAKEUP_FLAG = 1;
+
+    public:
+        using handler = inline_function<void(T &), HANDLER_SIZE_BYTES>;
+        using priority = thread::priority;
+
+        /**
+         * @brief Constructs the worker, without creating the kernel objects.
+         *
+         * @param f The handler, called on the worker thread for every posted element.
+         * @param prio The priority of the worker thread.
+         * @param name The name of the worker thread.
+         *
+         * @see createWorker()
+         */
+        template<class F>
+        explicit deferred_worker(F &&f, priority prio = priority(), const char *name = "N/A")
+            : static_thread<STACK_SIZE_BYTES>([this]() { work(); }, prio, name),
+              handle(std::forward<F>(f)), wakeup(name) {
+        }
+
+        ~deferred_worker() {
+            // the worker must not run anymore when the handler, the event flags and the ring are destroyed
+            this->deleteThread();
+        }
+
+        /**
+         * @brief Creates the kernel objects and starts the worker thread.
+         */
+        void createWorker() {
+            wakeup.createEventFlags();
+            this->createThread();
+            this->resume();
+        }
+
+        /**
+         * @brief Posts an element to the worker.
+         *
+         * @param item The element.
+         * @return true if the element has been posted, false if the ring is full and the element was dropped.
+         * @remark Thread and ISR context callable, from a single producer only
+         */
+        bool post(const T &item) {
+            bool caught_up;
+            if (!ring.push(item, caught_up)) {
+                dropped = dropped + 1;
+                return false;
+            }
+            if (caught_up) {
+                wakeup.set(WAKEUP_FLAG);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Get the number of elements dropped because the ring was full.
+         */
+        [[nodiscard]] std::uint32_t getDropped() const {
+            return dropped;
+        }
+
+    private:
+        void work() {
+            for (;;) {
+                T item;
+                while (ring.pop(item)) {
+                    handle(item);
+                }
+                wakeup.waitAny(WAKEUP_FLAG);
+            }
+        }
+
+        handler handle;
+        event_flags wakeup;
+        spsc_ring<T, N> ring;
+        volatile std::uint32_t dropped{};
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXDEFERREDWORKER_HPP
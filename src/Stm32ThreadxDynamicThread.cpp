@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include <new>
+#include "Stm32ThreadxDynamicThread.hpp"
+#include "Stm32ThreadxConfig.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+namespace {
+    // the AAPCS requires 8 byte alignment of the stack, the pool only guarantees ALIGN_TYPE
+    constexpr std::size_t STACK_ALIGNMENT = 8;
+    constexpr std::size_t ALIGNMENT = (alignof(dynamic_thread) > STACK_ALIGNMENT)
+                                          ? alignof(dynamic_thread)
+                                          : STACK_ALIGNMENT;
+
+    constexpr std::size_t roundUp(std::size_t size, std::size_t alignment) {
+        return (size + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+dynamic_thread *dynamic_thread::make(byte_pool &pool, std::size_t stack_size, priority prio, const char *name) {
+    STM32THREADXTHREAD_ASSERT(stack_size > 0);
+    constexpr std::size_t object_size = roundUp(sizeof(dynamic_thread), STACK_ALIGNMENT);
+    stack_size = roundUp(stack_size, STACK_ALIGNMENT);
+
+    void *block = pool.allocate(ALIGNMENT - 1 + object_size + stack_size, tick_timer::duration::zero());
+    if (block == nullptr) {
+        return nullptr;
+    }
+    auto *memory = reinterpret_cast<unsigned char *>(roundUp(reinterpret_cast<std::uintptr_t>(block), ALIGNMENT));
+    return ::new(memory) dynamic_thread(block, memory + object_size, static_cast<std::uint32_t>(stack_size),
+                                        prio, name);
+}
+
+void dynamic_thread::destroy(dynamic_thread *t) {
+    if (t == nullptr) {
+        return;
+    }
+    void *block = t->block;
+    t->~dynamic_thread();
+    byte_pool::release(block);
+}
+
+void dynamic_thread::invokeCallable(ULONG self) {
+    auto *t = reinterpret_cast<dynamic_thread *>(static_cast<std::uintptr_t>(self));
+    t->callable_();
+    if (t->owner != nullptr) {
+        // drop the captures now, not when the thread is reused
+        t->callable_.reset();
+        t->owner->recycle(*t);
+    }
+}
+
+
+thread_cache::thread_cache(byte_pool &pool, std::size_t stack_size, priority prio, const char *name)
+    : pool(pool), stack_size(stack_size), prio(prio), name(name) {
+}
+
+thread_cache::~thread_cache() {
+    trim();
+}
+
+void thread_cache::trim() {
+    while (auto *t = popIdle()) {
+        dynamic_thread::destroy(t);
+    }
+}
+
+dynamic_thread *thread_cache::acquire() {
+    auto *t = popIdle();
+    if (t == nullptr) {
+        t = dynamic_thread::make(pool, stack_size, prio, name);
+        if (t != nullptr) {
+            t->owner = this;
+            t->createThread();
+        }
+        return t;
+    }
+
+    // the thread may not have returned from its entry function yet, tx_thread_reset() needs it to be finished
+    const auto s = t->getSchedulingState();
+    if (s != thread::state::completed && s != thread::state::terminated) {
+        t->terminate();
+    }
+    t->reset();
+    if (t->getPriority() != prio) {
+        t->setPriority(prio);
+    }
+    return t;
+}
+
+void thread_cache::recycle(dynamic_thread &t) {
+    TX_INTERRUPT_SAVE_AREA
+    TX_DISABLE
+    t.next_idle = idle;
+    idle = &t;
+    ++idle_count;
+    TX_RESTORE
+}
+
+dynamic_thread *thread_cache::popIdle() {
+    dynamic_thread *t;
+
+    TX_INTERRUPT_SAVE_AREA
+    TX_DISABLE
+    t = idle;
+    if (t != nullptr) {
+        idle = t->next_idle;
+        --idle_count;
+    }
+    TX_RESTORE
+
+    return t;
+}
@@ -0,0 +1,233 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXDYNAMICTHREAD_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXDYNAMICTHREAD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "Stm32ThreadxThread.hpp"
+#include "Stm32ThreadxBytePool.hpp"
+
+namespace Stm32ThreadxThread {
+    class thread_cache;
+
+    /**
+     * @class dynamic_thread
+     * @brief Thread whose control block and stack are allocated together from a byte pool.
+     *
+     * The object and its stack live in one allocation, so creating a thread costs a single
+     * `tx_byte_allocate()`. Like every thread of this library, the thread is created by calling `createThread()`.
+     *
+     * @code
+     * auto *t = dynamic_thread::make(pool, 1024, [] { blink(); }, 5, "blink");
+     * t->createThread();
+     * t->resume();
+     * // ...
+     * dynamic_thread::destroy(t);
+     * @endcode
+     *
+     * @see byte_pool, thread_cache
+     */
+    class dynamic_thread : public thread {
+    public:
+        static constexpr std::size_t CALLABLE_SIZE = 4 * sizeof(void *);
+        using callable = inline_function<void(), CALLABLE_SIZE>;
+
+        ~dynamic_thread() {
+            // the thread must not run anymore when the callable is destroyed
+            deleteThread();
+        }
+
+        /**
+         * @brief Allocates and constructs a thread without an entry, set it with `setEntry()`.
+         *
+         * @param pool The pool to allocate the object and the stack from.
+         * @param stack_size The size of the stack in bytes.
+         * @param prio The priority of the thread.
+         * @param name The name of the thread.
+         * @return Pointer to the thread, nullptr if the pool doesn't have enough memory. The call never blocks.
+         * @remark Thread context callable
+         */
+        static dynamic_thread *make(byte_pool &pool, std::size_t stack_size,
+                                    priority prio = priority(), const char *name = DEFAULT_NAME);
+
+        /**
+         * @brief Allocates and constructs a thread running any callable.
+         *
+         * @param pool The pool to allocate the object and the stack from.
+         * @param stack_size The size of the stack in bytes.
+         * @param f The callable, invoked without arguments as the thread's entry function.
+         * @param prio The priority of the thread.
+         * @param name The name of the thread.
+         * @return Pointer to the thread, nullptr if the pool doesn't have enough memory. The call never blocks.
+         * @remark Thread context callable
+         */
+        template<class F, typename = typename std::enable_if<
+            std::is_invocable_r<void, typename std::decay<F>::type &>::value>::type>
+        static dynamic_thread *make(byte_pool &pool, std::size_t stack_size, F &&f,
+                                    priority prio = priority(), const char *name = DEFAULT_NAME) {
+            auto *t = make(pool, stack_size, prio, name);
+            if (t != nullptr) {
+                t->setEntry(std::forward<F>(f));
+            }
+            return t;
+        }
+
+        /**
+         * @brief Deletes the thread, if it is created, and releases its memory to the pool.
+         *
+         * @param t The thread, may be nullptr.
+         * @note Must not be called from the thread itself.
+         * @remark Thread context callable
+         */
+        static void destroy(dynamic_thread *t);
+
+        /**
+         * @brief Sets the callable run by the thread.
+         *
+         * @note Must only be called while the thread doesn't run, i.e. before it is resumed after `createThread()`
+         * or `reset()`.
+         */
+        template<class F>
+        void setEntry(F &&f) {
+            callable_ = std::forward<F>(f);
+        }
+
+    private:
+        friend class thread_cache;
+
+        dynamic_thread(void *block, void *pstack, std::uint32_t stack_size, priority prio, const char *name)
+            : thread(pstack, stack_size,
+                     &dynamic_thread::invokeCallable, static_cast<native::ULONG>(reinterpret_cast<std::uintptr_t>(this)),
+                     prio, name),
+              block(block) {
+        }
+
+        static void invokeCallable(native::ULONG self);
+
+        void *block{};
+        callable callable_{};
+        thread_cache *owner{};
+        dynamic_thread *next_idle{};
+    };
+
+
+    /**
+     * @class thread_cache
+     * @brief Spawns jobs on `dynamic_thread`s, recycling threads that have completed.
+     *
+     * A thread is put back into the cache when its job returns. The next `spawn()` reuses it with
+     * `tx_thread_reset()` instead of deleting and recreating it, so the byte pool is hit only while the
+     * number of concurrently running jobs grows. This keeps the spawn latency constant and the pool from
+     * fragmenting for dispatchers that spawn short-lived threads all the time.
+     *
+     * @code
+     * static_byte_pool<16384> pool("jobs");
+     * thread_cache jobs(pool, 1024, 10, "job");
+     * // ...
+     * pool.createBytePool();
+     * jobs.spawn([&] { handle(request); });
+     * @endcode
+     *
+     * @note The cache must outlive the jobs spawned on it. Recycled threads keep their creation index and
+     * stack fill, so `stackUsage()` reports the peak over all jobs that ran on a thread.
+     */
+    class thread_cache {
+    public:
+        using priority = thread::priority;
+
+        /**
+         * @param pool The pool to allocate threads from.
+         * @param stack_size The stack size of each thread in bytes.
+         * @param prio The priority every job starts with.
+         * @param name The name of the threads.
+         */
+        thread_cache(byte_pool &pool, std::size_t stack_size,
+                     priority prio = priority(), const char *name = DEFAULT_NAME);
+
+        /**
+         * @brief Destroys the idle threads.
+         */
+        ~thread_cache();
+
+        /**
+         * @brief Runs a callable on an idle thread, or on a new thread if none is idle.
+         *
+         * @param f The callable, must fit into `dynamic_thread::CALLABLE_SIZE` bytes.
+         * @return true if the job was started, false if no thread is idle and the pool doesn't have enough memory.
+         * The call never blocks.
+         * @remark Thread context callable
+         */
+        template<class F>
+        bool spawn(F &&f) {
+            auto *t = acquire();
+            if (t == nullptr) {
+                return false;
+            }
+            t->setEntry(std::forward<F>(f));
+            t->resume();
+            return true;
+        }
+
+        /**
+         * @brief Destroys the idle threads, releasing their memory to the pool.
+         * @remark Thread context callable
+         */
+        void trim();
+
+        /**
+         * @brief Get the number of idle threads.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] std::size_t getIdle() const {
+            return idle_count;
+        }
+
+    private:
+        friend class dynamic_thread;
+
+        static constexpr const char *DEFAULT_NAME = "N/A";
+
+        thread_cache(const thread_cache &) = delete;
+
+        thread_cache &operator=(const thread_cache &) = delete;
+
+        /**
+         * @brief Takes an idle thread and resets it, or makes a new one.
+         * @return A created, suspended thread, nullptr if the pool doesn't have enough memory.
+         */
+        dynamic_thread *acquire();
+
+        /**
+         * @brief Puts a thread back into the cache, called by the thread when its job has returned.
+         */
+        void recycle(dynamic_thread &t);
+
+        /**
+         * @brief Removes an idle thread from the cache.
+         * @return The thread, nullptr if there is none.
+         */
+        dynamic_thread *popIdle();
+
+        byte_pool &pool;
+        std::size_t stack_size;
+        priority prio;
+        const char *name;
+        dynamic_thread *idle{};
+        std::size_t idle_count{};
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXDYNAMICTHREAD_HPP
@@ -0,0 +1,40 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include <cassert>
+#include "Stm32ThreadxEventFlags.hpp"
+#include "Stm32ThreadxConfig.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+void event_flags::createEventFlags() {
+    // https://github.com/eclipse-threadx/rtos-docs/blob/main/rtos-docs/threadx/chapter4.md#tx_event_flags_create
+    auto result = tx_event_flags_create(
+        this, // TX_EVENT_FLAGS_GROUP *group_ptr
+        const_cast<char *>(name)); // CHAR *name_ptr
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+event_flags::~event_flags() {
+    if (!isCreated()) {
+        return;
+    }
+    auto result = tx_event_flags_delete(this);
+    assert(result == TX_SUCCESS);
+    (void) result;
+}
+
+bool event_flags::isCreated() const {
+    return tx_event_flags_group_id == TX_EVENT_FLAGS_ID;
+}
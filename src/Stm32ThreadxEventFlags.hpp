@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXEVENTFLAGS_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXEVENTFLAGS_HPP
+
+#include "tx_api.h"
+#include "Stm32ThreadxTickTimer.hpp"
+
+namespace Stm32ThreadxThread {
+    namespace native {
+        // these macros may use native type casts, so need some redirection
+        constexpr UINT FLAGS_OR = TX_OR;
+        constexpr UINT FLAGS_OR_CLEAR = TX_OR_CLEAR;
+        constexpr UINT FLAGS_AND = TX_AND;
+        constexpr UINT FLAGS_AND_CLEAR = TX_AND_CLEAR;
+        using UINT = UINT;
+        using ULONG = ULONG;
+        using TX_EVENT_FLAGS_GROUP = TX_EVENT_FLAGS_GROUP;
+    }
+
+    /**
+     * @class event_flags
+     * @brief Wraps a ThreadX event flags group of 32 flags.
+     *
+     * @note The event flags group must be created by calling `createEventFlags()` before it is used.
+     */
+    class event_flags : private native::TX_EVENT_FLAGS_GROUP {
+    public:
+        using flag_type = native::ULONG;
+
+        /**
+         * @brief Constructs an event flags object, without creating the kernel object.
+         *
+         * @param name The name of the event flags group.
+         *
+         * @see createEventFlags()
+         */
+        explicit event_flags(const char *name = DEFAULT_NAME)
+            : TX_EVENT_FLAGS_GROUP(), name(name) {
+        }
+
+        ~event_flags();
+
+        /**
+         * @brief Create the event flags group by calling `tx_event_flags_create()`.
+         */
+        void createEventFlags();
+
+        /**
+         * @brief Sets the given flags.
+         * @param flags The flags to set.
+         * @remark Thread and ISR context callable
+         */
+        void set(flag_type flags) {
+            tx_event_flags_set(this, flags, native::FLAGS_OR);
+        }
+
+        /**
+         * @brief Clears the given flags.
+         * @param flags The flags to clear.
+         * @remark Thread and ISR context callable
+         */
+        void clear(flag_type flags) {
+            tx_event_flags_set(this, ~flags, native::FLAGS_AND);
+        }
+
+        /**
+         * @brief Get the currently set flags.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] flag_type get() const {
+            return tx_event_flags_group_current;
+        }
+
+        /**
+         * @brief Waits until any of the given flags is set.
+         *
+         * @param flags The flags to wait for.
+         * @param rel_time The maximum duration to wait.
+         * @param clear If true, the received flags are cleared.
+         * @return The flags that were set when the wait completed, 0 if the timeout expired.
+         * @remark Thread context callable, ISR context callable with `rel_time` zero
+         */
+        flag_type waitAnyFor(flag_type flags, tick_timer::duration rel_time, bool clear = true) {
+            return wait(flags, clear ? native::FLAGS_OR_CLEAR : native::FLAGS_OR, rel_time);
+        }
+
+        template<class Rep, class Period>
+        flag_type waitAnyFor(flag_type flags, const std::chrono::duration<Rep, Period> &rel_time, bool clear = true) {
+            return waitAnyFor(flags, std::chrono::duration_cast<tick_timer::duration>(rel_time), clear);
+        }
+
+        /**
+         * @brief Waits until all the given flags are set.
+         *
+         * @param flags The flags to wait for.
+         * @param rel_time The maximum duration to wait.
+         * @param clear If true, the received flags are cleared.
+         * @return The flags that were set when the wait completed, 0 if the timeout expired.
+         * @remark Thread context callable, ISR context callable with `rel_time` zero
+         */
+        flag_type waitAllFor(flag_type flags, tick_timer::duration rel_time, bool clear = true) {
+            return wait(flags, clear ? native::FLAGS_AND_CLEAR : native::FLAGS_AND, rel_time);
+        }
+
+        template<class Rep, class Period>
+        flag_type waitAllFor(flag_type flags, const std::chrono::duration<Rep, Period> &rel_time, bool clear = true) {
+            return waitAllFor(flags, std::chrono::duration_cast<tick_timer::duration>(rel_time), clear);
+        }
+
+        /**
+         * @brief Waits without timeout until any of the given flags is set.
+         * @see waitAnyFor()
+         */
+        flag_type waitAny(flag_type flags, bool clear = true) {
+            return waitAnyFor(flags, infinity, clear);
+        }
+
+        /**
+         * @brief Waits without timeout until all the given flags are set.
+         * @see waitAllFor()
+         */
+        flag_type waitAll(flag_type flags, bool clear = true) {
+            return waitAllFor(flags, infinity, clear);
+        }
+
+    protected:
+        static constexpr const char *DEFAULT_NAME = "N/A";
+
+    private:
+        event_flags(const event_flags &) = delete;
+
+        event_flags &operator=(const event_flags &) = delete;
+
+        [[nodiscard]] bool isCreated() const;
+
+        flag_type wait(flag_type flags, native::UINT option, tick_timer::duration rel_time) {
+            flag_type actual = 0;
+            if (tx_event_flags_get(this, flags, option, &actual, toTicks(rel_time)) != TX_SUCCESS) {
+                return 0;
+            }
+            return actual;
+        }
+
+        const char *name{};
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXEVENTFLAGS_HPP
@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXINLINEFUNCTION_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXINLINEFUNCTION_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Stm32ThreadxThread {
+    template<class Signature, std::size_t CAPACITY>
+    class inline_function;
+
+    /**
+     * @class inline_function
+     * @brief Type-erased callable stored in a fixed inline buffer.
+     *
+     * Like `std::function`, but the callable is always stored inside the object, so there is no heap allocation.
+     * Callables larger than `CAPACITY` are rejected at compile time. Calls go through a function
+     * pointer generated for the stored type, there is no virtual dispatch.
+     *
+     * @tparam R The return type.
+     * @tparam Args The argument types.
+     * @tparam CAPACITY The size of the inline buffer in bytes.
+     */
+    template<class R, class... Args, std::size_t CAPACITY>
+    class inline_function<R(Args...), CAPACITY> {
+        static_assert(CAPACITY > 0, "CAPACITY must be greater than zero");
+
+        template<class F>
+        using enable_if_callable = typename std::enable_if<
+            !std::is_same<typename std::decay<F>::type, inline_function>::value &&
+            std::is_invocable_r<R, typename std::decay<F>::type &, Args...>::value>::type;
+
+    public:
+        static constexpr std::size_t SIZE = CAPACITY;
+
+        inline_function() noexcept = default;
+
+        inline_function(std::nullptr_t) noexcept {
+        }
+
+        template<class F, typename = enable_if_callable<F> >
+        inline_function(F &&f) {
+            emplace(std::forward<F>(f));
+        }
+
+        inline_function(inline_function &&other) noexcept {
+            moveFrom(other);
+        }
+
+        inline_function &operator=(inline_function &&other) noexcept {
+            if (this != &other) {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        inline_function(const inline_function &) = delete;
+
+        inline_function &operator=(const inline_function &) = delete;
+
+        ~inline_function() {
+            reset();
+        }
+
+        /**
+         * @brief Stores a new callable, destroying the previous one.
+         */
+        template<class F, typename = enable_if_callable<F> >
+        void emplace(F &&f) {
+            using D = typename std::decay<F>::type;
+            static_assert(sizeof(D) <= CAPACITY, "callable does not fit in the inline buffer, increase its size");
+            static_assert(alignof(D) <= alignof(std::max_align_t), "callable is over-aligned");
+            reset();
+            ::new(static_cast<void *>(storage)) D(std::forward<F>(f));
+            invoker = &invoke<D>;
+            manager = &manage<D>;
+        }
+
+        /**
+         * @brief Destroys the stored callable, if any.
+         */
+        void reset() noexcept {
+            if (manager != nullptr) {
+                manager(operation::destroy, storage, nullptr);
+            }
+            invoker = nullptr;
+            manager = nullptr;
+        }
+
+        explicit operator bool() const noexcept {
+            return invoker != nullptr;
+        }
+
+        R operator()(Args... args) {
+            return invoker(storage, std::forward<Args>(args)...);
+        }
+
+    private:
+        enum class operation {
+            move,
+            destroy,
+        };
+
+        template<class D>
+        static R invoke(void *callable, Args &&... args) {
+            return (*static_cast<D *>(callable))(std::forward<Args>(args)...);
+        }
+
+        template<class D>
+        static void manage(operation op, void *dst, void *src) {
+            if (op == operation::move) {
+                ::new(dst) D(std::move(*static_cast<D *>(src)));
+                static_cast<D *>(src)->~D();
+            } else {
+                static_cast<D *>(dst)->~D();
+            }
+        }
+
+        void moveFrom(inline_function &other) noexcept {
+            if (other.manager != nullptr) {
+                other.manager(operation::move, storage, other.storage);
+            }
+            invoker = other.invoker;
+            manager = other.manager;
+            other.invoker = nullptr;
+            other.manager = nullptr;
+        }
+
+        alignas(std::max_align_t) unsigned char storage[CAPACITY]{};
+        R (*invoker)(void *callable, Args &&... args){};
+        void (*manager)(operation op, void *dst, void *src){};
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXINLINEFUNCTION_HPP
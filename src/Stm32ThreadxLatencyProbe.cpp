@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+#include "Stm32ThreadxLatencyProbe.hpp"
+
+#ifdef STM32THREADXTHREAD_HAS_CYCLE_CLOCK
+
+#include "Stm32ThreadxThread.hpp"
+#include "tx_thread.h"
+
+using namespace Stm32ThreadxThread;
+
+std::uint32_t detail::latencyProbeSlot() {
+    // the interrupted thread is still current in an ISR, so check the system state first
+    if (TX_THREAD_GET_SYSTEM_STATE() != 0) {
+        return 0;
+    }
+    const auto *t = thread::getCurrent();
+    return (t != nullptr) ? t->getIndex() + 1 : 0;
+}
+
+#endif // STM32THREADXTHREAD_HAS_CYCLE_CLOCK
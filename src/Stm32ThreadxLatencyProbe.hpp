@@ -0,0 +1,251 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXLATENCYPROBE_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXLATENCYPROBE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "tx_api.h"
+#include "Stm32ThreadxTickTimer.hpp"
+
+#ifdef STM32THREADXTHREAD_HAS_CYCLE_CLOCK
+
+namespace Stm32ThreadxThread {
+    /**
+     * @struct latency_histogram
+     * @brief Snapshot of a `latency_probe`, in `cycle_clock` cycles.
+     *
+     * Bucket 0 counts durations of zero cycles, bucket `b > 0` counts durations in `[2^(b-1), 2^b)`,
+     * the last bucket also counts all longer durations.
+     */
+    template<std::size_t BUCKETS>
+    struct latency_histogram {
+        std::uint32_t counts[BUCKETS]; ///< Number of durations in each bucket
+        std::uint32_t samples; ///< Total number of durations
+        std::uint32_t max; ///< Longest duration
+
+        /**
+         * @brief Get the upper bound of a bucket.
+         *
+         * The last bucket is open-ended, the bound returned for it only holds for the durations in its range,
+         * longer durations are bounded by `max`.
+         */
+        static constexpr std::uint32_t upperBound(std::size_t bucket) {
+            return (bucket == 0) ? 0 : (bucket >= 32) ? UINT32_MAX : static_cast<std::uint32_t>((1ULL << bucket) - 1);
+        }
+
+        /**
+         * @brief Get an upper bound of the given percentile.
+         *
+         * @param per_mille The percentile in per mille, e.g. 500 for the median or 990 for p99.
+         * @return The upper bound of the bucket containing the percentile, at most `max`. `max` if the percentile
+         * is in the open-ended last bucket.
+         */
+        [[nodiscard]] cycle_clock::duration percentile(std::uint32_t per_mille) const {
+            if (samples == 0) {
+                return cycle_clock::duration::zero();
+            }
+            const auto rank = (static_cast<std::uint64_t>(samples) * per_mille + 999) / 1000;
+            std::uint64_t cumulative = 0;
+            for (std::size_t b = 0; b < BUCKETS; ++b) {
+                cumulative += counts[b];
+                if (cumulative >= rank) {
+                    if (b == BUCKETS - 1) {
+                        return cycle_clock::duration(max);
+                    }
+                    return cycle_clock::duration(upperBound(b) < max ? upperBound(b) : max);
+                }
+            }
+            return cycle_clock::duration(max);
+        }
+
+        [[nodiscard]] cycle_clock::duration p50() const {
+            return percentile(500);
+        }
+
+        [[nodiscard]] cycle_clock::duration p99() const {
+            return percentile(990);
+        }
+    };
+
+    namespace detail {
+        /**
+         * @brief Get the shard slot of the calling context.
+         * @return 0 for ISRs, initialization and threads not created by this library, otherwise the creation
+         * index of the current thread plus one.
+         */
+        std::uint32_t latencyProbeSlot();
+    }
+
+    /**
+     * @class latency_probe
+     * @brief Log-bucketed histogram of region durations in static memory.
+     *
+     * Durations are recorded into per-thread shards selected by the creation index of the current thread,
+     * so recording takes no lock. Shard 0 is shared by ISRs and foreign threads and is updated with interrupts
+     * disabled. If more library threads record than there are shards, some threads share a shard and a sample may
+     * occasionally be lost when they preempt each other while recording.
+     *
+     * @code
+     * LATENCY_PROBE_DEFINE(controlLoop);
+     *
+     * void control() {
+     *     for (;;) {
+     *         LATENCY_PROBE(controlLoop);
+     *         ...
+     *     }
+     * }
+     *
+     * // diagnostic thread
+     * auto h = controlLoop.snapshot();
+     * controlLoop.reset();
+     * @endcode
+     *
+     * @tparam SHARDS The number of shards, including the shared shard 0.
+     * @tparam BUCKETS The number of log2 buckets.
+     */
+    template<std::size_t SHARDS = 8, std::size_t BUCKETS = 24>
+    class latency_probe {
+        static_assert(SHARDS >= 2, "SHARDS must be at least 2");
+        static_assert(BUCKETS >= 2 && BUCKETS <= 33, "BUCKETS must be in 2..33");
+
+    public:
+        using histogram = latency_histogram<BUCKETS>;
+
+        constexpr explicit latency_probe(const char *name) : name(name) {
+        }
+
+        latency_probe(const latency_probe &) = delete;
+
+        latency_probe &operator=(const latency_probe &) = delete;
+
+        /**
+         * @brief Records a duration.
+         * @remark Thread and ISR context callable
+         */
+        void record(cycle_clock::duration d) {
+            const std::uint32_t slot = detail::latencyProbeSlot();
+            if (slot == 0) {
+                TX_INTERRUPT_SAVE_AREA
+                TX_DISABLE
+                shards[0].add(d.count());
+                TX_RESTORE
+            } else {
+                shards[1 + (slot - 1) % (SHARDS - 1)].add(d.count());
+            }
+        }
+
+        /**
+         * @brief Merges all shards into a histogram.
+         *
+         * Durations recorded concurrently may or may not be included.
+         * @remark Thread context callable
+         */
+        [[nodiscard]] histogram snapshot() const {
+            histogram h{};
+            for (const auto &s: shards) {
+                for (std::size_t b = 0; b < BUCKETS; ++b) {
+                    h.counts[b] += s.counts[b];
+                }
+                h.samples += s.samples;
+                h.max = (s.max > h.max) ? s.max : h.max;
+            }
+            return h;
+        }
+
+        /**
+         * @brief Clears all shards.
+         *
+         * Durations recorded concurrently may be lost.
+         * @remark Thread context callable
+         */
+        void reset() {
+            for (auto &s: shards) {
+                s = shard{};
+            }
+        }
+
+        [[nodiscard]] const char *getName() const {
+            return name;
+        }
+
+        /**
+         * @brief Get the bucket of a duration in cycles.
+         */
+        static constexpr std::size_t bucketOf(std::uint32_t cycles) {
+            std::size_t b = 0;
+            while (cycles != 0) {
+                cycles >>= 1;
+                ++b;
+            }
+            return (b < BUCKETS) ? b : BUCKETS - 1;
+        }
+
+    private:
+        struct shard {
+            std::uint32_t counts[BUCKETS]{};
+            std::uint32_t samples{};
+            std::uint32_t max{};
+
+            void add(std::uint32_t cycles) {
+                ++counts[bucketOf(cycles)];
+                ++samples;
+                if (cycles > max) {
+                    max = cycles;
+                }
+            }
+        };
+
+        const char *name;
+        shard shards[SHARDS]{};
+    };
+
+    /**
+     * @class scoped_timer
+     * @brief Records the lifetime of the object into a `latency_probe`.
+     */
+    template<class Probe>
+    class scoped_timer {
+    public:
+        explicit scoped_timer(Probe &probe) : probe(probe), start(cycle_clock::now()) {
+        }
+
+        ~scoped_timer() {
+            probe.record(cycle_clock::now() - start);
+        }
+
+        scoped_timer(const scoped_timer &) = delete;
+
+        scoped_timer &operator=(const scoped_timer &) = delete;
+
+    private:
+        Probe &probe;
+        cycle_clock::time_point start;
+    };
+}
+
+/**
+ * @brief Defines a `latency_probe<>` named `name`, at namespace scope.
+ */
+#define LATENCY_PROBE_DEFINE(name) \
+    ::Stm32ThreadxThread::latency_probe<> name{#name}
+
+/**
+ * @brief Records the duration from here to the end of the enclosing scope into the probe `name`.
+ */
+#define LATENCY_PROBE(name) \
+    ::Stm32ThreadxThread::scoped_timer<decltype(name)> name##_scoped_timer{name}
+
+#endif // STM32THREADXTHREAD_HAS_CYCLE_CLOCK
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXLATENCYPROBE_HPP
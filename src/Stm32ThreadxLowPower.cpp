@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+#include "Stm32ThreadxLowPower.hpp"
+
+#ifdef TX_LOW_POWER
+
+#include <algorithm>
+#include <limits>
+#include "Stm32ThreadxThread.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+namespace {
+    constexpr std::uint32_t NO_LIMIT = std::numeric_limits<std::uint32_t>::max();
+
+    const low_power::driver *active_driver = nullptr;
+    // minimum of all threads, in microseconds so it can be read atomically from the idle path
+    volatile std::uint32_t wakeup_latency_us = NO_LIMIT;
+    std::uint32_t next_expiration = 0;
+    bool expiration_pending = false;
+    low_power::depth last_depth = low_power::depth::sleep;
+}
+
+void low_power::setDriver(const driver *drv) {
+    active_driver = drv;
+}
+
+low_power::latency low_power::getWakeupLatency() {
+    const std::uint32_t us = wakeup_latency_us;
+    return (us == NO_LIMIT) ? latency::max() : latency(us);
+}
+
+low_power::depth low_power::getLastDepth() {
+    return last_depth;
+}
+
+void low_power::updateWakeupLatency() {
+    latency minimum = latency::max();
+    thread::forEach([&minimum](thread &t) {
+        minimum = std::min(minimum, t.getMaxWakeupLatency());
+    });
+    wakeup_latency_us = (minimum >= latency(NO_LIMIT)) ? NO_LIMIT : static_cast<std::uint32_t>(minimum.count());
+}
+
+void low_power::setupTimer(std::uint32_t ticks) {
+    next_expiration = ticks;
+    expiration_pending = true;
+    if (active_driver != nullptr) {
+        active_driver->setupTimer(ticks);
+    }
+}
+
+void low_power::enter() {
+    if (active_driver == nullptr) {
+        expiration_pending = false;
+        return;
+    }
+    last_depth = selectDepth();
+    active_driver->enter(last_depth);
+}
+
+void low_power::exit() {
+    if ((active_driver != nullptr) && (active_driver->exit != nullptr)) {
+        active_driver->exit(last_depth);
+    }
+    expiration_pending = false;
+}
+
+std::uint32_t low_power::adjustTimer() {
+    return (active_driver != nullptr) ? active_driver->adjustTimer() : 0;
+}
+
+low_power::depth low_power::selectDepth() {
+    const latency tolerated = getWakeupLatency();
+    const latency idle = expiration_pending
+                             ? std::chrono::duration_cast<latency>(tick_timer::duration(next_expiration))
+                             : latency::max();
+    for (auto d = DEPTH_COUNT - 1; d > 0; --d) {
+        const latency exit_latency = active_driver->exit_latency[d];
+        if ((exit_latency <= tolerated) && (exit_latency < idle)) {
+            return static_cast<depth>(d);
+        }
+    }
+    return depth::sleep;
+}
+
+extern "C" {
+void stm32threadxthread_low_power_timer_setup(std::uint32_t ticks) {
+    low_power::setupTimer(ticks);
+}
+
+void stm32threadxthread_low_power_enter() {
+    low_power::enter();
+}
+
+void stm32threadxthread_low_power_exit() {
+    low_power::exit();
+}
+
+std::uint32_t stm32threadxthread_low_power_timer_adjust() {
+    return low_power::adjustTimer();
+}
+}
+
+#endif // TX_LOW_POWER
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXLOWPOWER_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXLOWPOWER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "tx_api.h"
+
+#ifdef TX_LOW_POWER
+
+#include "Stm32ThreadxLowPowerHooks.h"
+
+namespace Stm32ThreadxThread {
+    /**
+     * @class low_power
+     * @brief Tickless idle engine on top of the ThreadX low power utility.
+     *
+     * When the system becomes idle, `tx_low_power_enter()` reports the ticks until the next timer expiration,
+     * which are passed to the driver to program a low power timer like the LPTIM or the RTC wakeup timer.
+     * The engine then selects the deepest sleep depth whose exit latency is tolerated by all threads and is
+     * shorter than the expected idle time, and lets the driver enter it. On wakeup `tx_low_power_exit()`
+     * corrects the tick count by the ticks the driver reports as elapsed.
+     *
+     * Threads declare the latency they tolerate with `thread::setMaxWakeupLatency()`. The minimum over all
+     * threads is cached, so the idle path doesn't walk the thread list.
+     *
+     * @see Stm32ThreadxLowPowerHooks.h
+     */
+    class low_power {
+    public:
+        using latency = std::chrono::microseconds;
+
+        /**
+         * @brief Sleep depths, ordered from the shallowest to the deepest.
+         */
+        enum class depth : std::uint8_t {
+            sleep, ///< CPU clock stopped, e.g. WFI in SLEEP mode
+            stop0, ///< STOP0 or the shallowest stop mode of the device
+            stop1, ///< STOP1
+            stop2 ///< STOP2 or the deepest mode retaining RAM
+        };
+
+        static constexpr std::size_t DEPTH_COUNT = 4;
+
+        /**
+         * @struct driver
+         * @brief Device specific part of the tickless idle.
+         *
+         * All functions are called from the idle path of the scheduler with interrupts disabled.
+         */
+        struct driver {
+            /// Programs the low power timer to wake up after `ticks` kernel ticks
+            void (*setupTimer)(std::uint32_t ticks);
+            /// Stops the low power timer and returns the kernel ticks elapsed while sleeping
+            std::uint32_t (*adjustTimer)();
+            /// Enters the sleep depth and returns after wakeup
+            void (*enter)(depth d);
+            /// Restores clocks after leaving the sleep depth, may be nullptr
+            void (*exit)(depth d);
+            /// Worst-case time from a wakeup event to running code, for each depth
+            latency exit_latency[DEPTH_COUNT];
+        };
+
+        /**
+         * @brief Installs the device driver, nullptr disables low power entry.
+         * @param drv The driver, must stay valid while it is installed.
+         */
+        static void setDriver(const driver *drv);
+
+        /**
+         * @brief Get the minimum wakeup latency tolerated by all created threads.
+         */
+        static latency getWakeupLatency();
+
+        /**
+         * @brief Get the sleep depth entered last.
+         */
+        static depth getLastDepth();
+
+        /**
+         * @brief Recomputes the cached minimum tolerated wakeup latency.
+         *
+         * Called by `thread` when a thread's latency changes or a thread with a latency is created or deleted.
+         */
+        static void updateWakeupLatency();
+
+        /**
+         * @brief Hooks called by the ThreadX low power utility.
+         * @see Stm32ThreadxLowPowerHooks.h
+         */
+        static void setupTimer(std::uint32_t ticks);
+
+        static void enter();
+
+        static void exit();
+
+        static std::uint32_t adjustTimer();
+
+    private:
+        static depth selectDepth();
+    };
+}
+
+#endif // TX_LOW_POWER
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXLOWPOWER_HPP
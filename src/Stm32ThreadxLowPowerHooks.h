@@ -0,0 +1,54 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+/**
+ * @file Stm32ThreadxLowPowerHooks.h
+ * @brief Connects the ThreadX low power utility to `Stm32ThreadxThread::low_power`.
+ *
+ * Include this header from `tx_user.h` together with `#define TX_LOW_POWER`, and optionally
+ * `#define TX_LOW_POWER_TICKLESS`. It maps the `TX_LOW_POWER_*` macros used by `tx_low_power_enter()` and
+ * `tx_low_power_exit()` to the hooks below, which forward to the installed `low_power::driver`.
+ * Macros defined before this header is included are left untouched.
+ */
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXLOWPOWERHOOKS_H
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXLOWPOWERHOOKS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void stm32threadxthread_low_power_timer_setup(uint32_t ticks);
+void stm32threadxthread_low_power_enter(void);
+void stm32threadxthread_low_power_exit(void);
+uint32_t stm32threadxthread_low_power_timer_adjust(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifndef TX_LOW_POWER_TIMER_SETUP
+#define TX_LOW_POWER_TIMER_SETUP(ticks) stm32threadxthread_low_power_timer_setup(ticks)
+#endif
+#ifndef TX_LOW_POWER_USER_ENTER
+#define TX_LOW_POWER_USER_ENTER stm32threadxthread_low_power_enter()
+#endif
+#ifndef TX_LOW_POWER_USER_EXIT
+#define TX_LOW_POWER_USER_EXIT stm32threadxthread_low_power_exit()
+#endif
+#ifndef TX_LOW_POWER_USER_TIMER_ADJUST
+#define TX_LOW_POWER_USER_TIMER_ADJUST stm32threadxthread_low_power_timer_adjust()
+#endif
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXLOWPOWERHOOKS_H
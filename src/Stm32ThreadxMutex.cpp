@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include <cassert>
+#include "Stm32ThreadxMutex.hpp"
+#include "Stm32ThreadxConfig.hpp"
+#include "tx_thread.h"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+void mutex::createMutex() {
+    // https://github.com/eclipse-threadx/rtos-docs/blob/main/rtos-docs/threadx/chapter4.md#tx_mutex_create
+    auto result = tx_mutex_create(
+        this, // TX_MUTEX *mutex_ptr
+        const_cast<char *>(name), // CHAR *name_ptr
+        inherit); // UINT priority_inherit
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+mutex::~mutex() {
+    if (!isCreated()) {
+        return;
+    }
+    auto result = tx_mutex_delete(this);
+    assert(result == TX_SUCCESS);
+    (void) result;
+}
+
+bool mutex::try_lock() {
+    // the interrupted thread is still current in an ISR, so check the system state
+    STM32THREADXTHREAD_ASSERT(TX_THREAD_GET_SYSTEM_STATE() == 0);
+    auto result = tx_mutex_get(this, TX_NO_WAIT);
+    STM32THREADXTHREAD_ASSERT(result != TX_CALLER_ERROR);
+    return result == TX_SUCCESS;
+}
+
+bool mutex::isCreated() const {
+    return tx_mutex_id == TX_MUTEX_ID;
+}
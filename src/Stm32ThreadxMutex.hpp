@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXMUTEX_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXMUTEX_HPP
+
+#include <cassert>
+#include "tx_api.h"
+#include "Stm32ThreadxTickTimer.hpp"
+
+namespace Stm32ThreadxThread {
+    namespace native {
+        // these macros may use native type casts, so need some redirection
+        constexpr UINT INHERIT = TX_INHERIT;
+        constexpr UINT NO_INHERIT = TX_NO_INHERIT;
+        using UINT = UINT;
+        using TX_MUTEX = TX_MUTEX;
+    }
+
+    /**
+     * @class mutex
+     * @brief Wraps a ThreadX mutex.
+     *
+     * The class satisfies the `TimedLockable` requirements, so it can be used with `std::lock_guard`,
+     * `std::unique_lock` and `std::scoped_lock`.
+     *
+     * @note ThreadX mutexes are recursive: the owning thread may lock the mutex again, and has to unlock it
+     * the same number of times.
+     * @note The mutex must be created by calling `createMutex()` before it is used.
+     */
+    class mutex : private native::TX_MUTEX {
+    public:
+        /**
+         * @brief Constructs a mutex object, without creating the kernel object.
+         *
+         * @param priority_inherit If true, a lower priority owner is raised to the priority of the highest priority
+         * thread waiting for the mutex, which prevents priority inversion.
+         * @param name The name of the mutex.
+         *
+         * @see createMutex()
+         */
+        explicit mutex(bool priority_inherit = true, const char *name = DEFAULT_NAME)
+            : TX_MUTEX(), inherit(priority_inherit ? native::INHERIT : native::NO_INHERIT), name(name) {
+        }
+
+        ~mutex();
+
+        /**
+         * @brief Create the mutex by calling `tx_mutex_create()`.
+         */
+        void createMutex();
+
+        /**
+         * @brief Locks the mutex, blocks until the mutex is available.
+         * @remark Thread context callable
+         */
+        void lock() {
+            auto result = tx_mutex_get(this, TX_WAIT_FOREVER);
+            assert(result == TX_SUCCESS);
+            (void) result;
+        }
+
+        /**
+         * @brief Tries to lock the mutex without blocking.
+         * @return true if the mutex has been locked, false otherwise
+         * @remark Thread context callable, a mutex is owned by a thread
+         */
+        bool try_lock();
+
+        /**
+         * @brief Tries to lock the mutex, blocks until the mutex is available or the timeout expires.
+         * @param rel_time The maximum duration to wait.
+         * @return true if the mutex has been locked, false otherwise
+         * @remark Thread context callable
+         */
+        bool try_lock_for(tick_timer::duration rel_time) {
+            return tx_mutex_get(this, toTicks(rel_time)) == TX_SUCCESS;
+        }
+
+        template<class Rep, class Period>
+        bool try_lock_for(const std::chrono::duration<Rep, Period> &rel_time) {
+            return try_lock_for(std::chrono::duration_cast<tick_timer::duration>(rel_time));
+        }
+
+        /**
+         * @brief Tries to lock the mutex, blocks until the mutex is available or the deadline is reached.
+         * @param abs_time The deadline.
+         * @return true if the mutex has been locked, false otherwise
+         * @remark Thread context callable
+         */
+        template<class Clock, class Duration>
+        bool try_lock_until(const std::chrono::time_point<Clock, Duration> &abs_time) {
+            const auto now = Clock::now();
+            return (abs_time > now) ? try_lock_for(abs_time - now) : try_lock();
+        }
+
+        /**
+         * @brief Unlocks the mutex.
+         * @remark Thread context callable, by the owner of the mutex only
+         */
+        void unlock() {
+            auto result = tx_mutex_put(this);
+            assert(result == TX_SUCCESS);
+            (void) result;
+        }
+
+    protected:
+        static constexpr const char *DEFAULT_NAME = "N/A";
+
+    private:
+        mutex(const mutex &) = delete;
+
+        mutex &operator=(const mutex &) = delete;
+
+        [[nodiscard]] bool isCreated() const;
+
+        native::UINT inherit{};
+        const char *name{};
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXMUTEX_HPP
@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include "Stm32ThreadxPeriodicTimer.hpp"
+#include "Stm32ThreadxThread.hpp"
+#include "Stm32ThreadxConfig.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+periodic_timer::periodic_timer(tick_timer::duration period)
+    : periodic_timer(period, tick_timer::now()) {
+}
+
+periodic_timer::periodic_timer(tick_timer::duration period, tick_timer::time_point start)
+    : period(period), deadline(start + period) {
+    STM32THREADXTHREAD_ASSERT(period.count() > 0);
+}
+
+std::uint32_t periodic_timer::wait() {
+    if (this_thread::sleepUntil(deadline)) {
+        deadline += period;
+        return 0;
+    }
+
+    // deadline passed, skip all deadlines up to now but stay in phase
+    const tick_timer::rep late = toTicks(tick_timer::now()) - toTicks(deadline);
+    if (late == 0) {
+        // reached exactly, on time
+        deadline += period;
+        return 0;
+    }
+    const auto missed = static_cast<std::uint32_t>(late / toTicks(period)) + 1;
+    deadline += period * missed;
+    return missed;
+}
+
+void periodic_timer::reset() {
+    reset(tick_timer::now());
+}
+
+void periodic_timer::reset(tick_timer::time_point start) {
+    deadline = start + period;
+}
+
+tick_timer::time_point periodic_timer::getNextDeadline() const {
+    return deadline;
+}
+
+tick_timer::duration periodic_timer::getPeriod() const {
+    return period;
+}
+
+void periodic_timer::setPeriod(tick_timer::duration period) {
+    STM32THREADXTHREAD_ASSERT(period.count() > 0);
+    this->period = period;
+}
@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXPERIODICTIMER_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXPERIODICTIMER_HPP
+
+#include <cstdint>
+#include "Stm32ThreadxTickTimer.hpp"
+
+namespace Stm32ThreadxThread {
+    /**
+     * @class periodic_timer
+     * @brief Drift-free periodic wakeups of the current thread.
+     *
+     * The timer keeps the next absolute deadline in `tick_timer` ticks and advances it by exactly one period
+     * on every wakeup. Jitter of a single wakeup therefore never accumulates into a phase drift.
+     *
+     * @code
+     * periodic_timer timer(std::chrono::milliseconds(1));
+     * for (;;) {
+     *     timer.wait();
+     *     sample();
+     * }
+     * @endcode
+     */
+    class periodic_timer {
+    public:
+        /**
+         * @brief Creates a periodic timer with the first deadline one period from now.
+         *
+         * @param period The period between two deadlines.
+         */
+        explicit periodic_timer(tick_timer::duration period);
+
+        /**
+         * @brief Creates a periodic timer with the first deadline one period after `start`.
+         *
+         * @param period The period between two deadlines.
+         * @param start The time point the phase of the timer is aligned to.
+         */
+        periodic_timer(tick_timer::duration period, tick_timer::time_point start);
+
+        /**
+         * @brief Blocks the current thread until the next deadline.
+         *
+         * If the deadline has already passed, the function returns immediately. The next deadline is moved to the
+         * first deadline in the future which is in phase with the original ones.
+         *
+         * @return 0 if the thread slept until the deadline, otherwise the number of deadlines which had
+         * already passed when the function was called.
+         */
+        std::uint32_t wait();
+
+        /**
+         * @brief Restarts the timer with the first deadline one period from now.
+         */
+        void reset();
+
+        /**
+         * @brief Restarts the timer with the first deadline one period after `start`.
+         *
+         * @param start The time point the phase of the timer is aligned to.
+         */
+        void reset(tick_timer::time_point start);
+
+        /**
+         * @brief Get the next absolute deadline.
+         */
+        [[nodiscard]] tick_timer::time_point getNextDeadline() const;
+
+        /**
+         * @brief Get the period of the timer.
+         */
+        [[nodiscard]] tick_timer::duration getPeriod() const;
+
+        /**
+         * @brief Set the period of the timer.
+         *
+         * The new period is used from the next deadline on. The deadline which is currently pending is not changed.
+         *
+         * @param period The new period between two deadlines.
+         */
+        void setPeriod(tick_timer::duration period);
+
+    private:
+        tick_timer::duration period;
+        tick_timer::time_point deadline;
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXPERIODICTIMER_HPP
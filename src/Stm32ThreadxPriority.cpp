@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include <algorithm>
+#include "Stm32ThreadxPriority.hpp"
+#include "Stm32ThreadxConfig.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+priority_boost::priority_boost(thread::priority prio, mode m)
+    : thread_ptr(native::currentThread()), m(m) {
+    if (thread_ptr == nullptr) {
+        return;
+    }
+    old_priority = thread_ptr->tx_thread_user_priority;
+    old_threshold = thread_ptr->tx_thread_user_preempt_threshold;
+
+    UINT old_value;
+    if (m == mode::priority) {
+        if (prio >= old_priority) {
+            return;
+        }
+        boosted = tx_thread_priority_change(thread_ptr, prio, &old_value) == TX_SUCCESS;
+        // changing the priority has reset the preemption-threshold to the priority,
+        // keep a threshold above the boost, else the region gets preemptible by more threads
+        if (boosted && old_threshold < prio) {
+            auto result = tx_thread_preemption_change(thread_ptr, old_threshold, &old_value);
+            STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+            (void) result;
+        }
+    } else {
+        if (prio >= old_threshold) {
+            return;
+        }
+        boosted = tx_thread_preemption_change(thread_ptr, prio, &old_value) == TX_SUCCESS;
+    }
+}
+
+priority_boost::~priority_boost() {
+    if (!boosted) {
+        return;
+    }
+    UINT old_value;
+    if (m == mode::priority) {
+        auto result = tx_thread_priority_change(thread_ptr, old_priority, &old_value);
+        STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+        (void) result;
+        // changing the priority has reset the preemption-threshold to the priority
+        if (old_threshold >= old_priority) {
+            return;
+        }
+    }
+    auto result = tx_thread_preemption_change(thread_ptr, old_threshold, &old_value);
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+
+void priority_ceiling::lock() {
+    auto *current = native::currentThread();
+    STM32THREADXTHREAD_ASSERT(current != nullptr);
+    // else the ceiling doesn't lock out other users
+    STM32THREADXTHREAD_ASSERT(current->tx_thread_user_priority >= ceiling);
+
+    if (current->tx_thread_user_preempt_threshold <= ceiling) {
+        // already running at or above the ceiling, e.g. another lock with a higher ceiling is held
+        return;
+    }
+    UINT previous;
+    auto result = tx_thread_preemption_change(current, ceiling, &previous);
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+    // no other user of the lock can run from here on
+    owner = current;
+    old_threshold = previous;
+    raised = true;
+}
+
+void priority_ceiling::unlock() {
+    if (!raised || owner != native::currentThread()) {
+        return;
+    }
+    raised = false;
+    UINT previous;
+    auto result = tx_thread_preemption_change(owner, old_threshold, &previous);
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+
+#ifdef TX_EXECUTION_PROFILE_ENABLE
+
+bool adaptive_priority::add(thread &t, thread::priority limit, load_type min_load) {
+    if (count >= capacity) {
+        return false;
+    }
+    const auto base = t.getPriority();
+    STM32THREADXTHREAD_ASSERT(limit <= base);
+    entries[count++] = entry{&t, base, limit, t.getPreemptThreshold(), min_load};
+    return true;
+}
+
+void adaptive_priority::update(const profiler &p) {
+    const bool busy = p.getTotalLoad() >= busy_load;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto &e = entries[i];
+        const auto prio = e.t->getPriority();
+        const bool starving = busy && p.getLoad(*e.t) < e.min_load;
+
+        // numerically lower is higher, step by one level per sample
+        thread::priority next = prio;
+        if (starving && prio > e.limit) {
+            next = prio - 1;
+        } else if (!starving && prio < e.base) {
+            next = prio + 1;
+        }
+        if (next == prio) {
+            continue;
+        }
+
+        // tx_thread_priority_change() resets the preemption threshold to the priority,
+        // restore it as far as it is allowed, a threshold must not be lower in priority
+        e.t->setPriority(next);
+        const auto threshold = std::min(e.threshold, next);
+        if (threshold != next) {
+            e.t->setPreemptThreshold(threshold);
+        }
+    }
+}
+
+#endif // TX_EXECUTION_PROFILE_ENABLE
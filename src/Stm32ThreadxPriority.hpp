@@ -0,0 +1,242 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXPRIORITY_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXPRIORITY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "Stm32ThreadxThread.hpp"
+#include "Stm32ThreadxProfiler.hpp"
+
+namespace Stm32ThreadxThread {
+    /**
+     * @class priority_boost
+     * @brief Scoped guard raising the current thread's priority or preemption-threshold.
+     *
+     * The value is only changed if it raises the thread, i.e. if it is numerically lower than the current one.
+     * Otherwise neither the constructor nor the destructor calls the kernel.
+     *
+     * @code
+     * {
+     *     priority_boost boost(2, priority_boost::mode::threshold);
+     *     // not preempted by threads of priority 2 and lower
+     *     spi.transfer(frame);
+     * }
+     * @endcode
+     *
+     * @note Must be created and destroyed by the same thread, nested guards must be destroyed in reverse order.
+     */
+    class priority_boost {
+    public:
+        enum class mode {
+            priority, ///< Changes the priority with `tx_thread_priority_change()`
+            threshold, ///< Changes the preemption-threshold with `tx_thread_preemption_change()`
+        };
+
+        /**
+         * @brief Raises the current thread to the given priority or preemption-threshold.
+         *
+         * @param prio The priority or preemption-threshold.
+         * @param m Whether the priority or only the preemption-threshold is raised. Raising the
+         * preemption-threshold keeps other threads from preempting the region, without changing the position
+         * of the thread in the ready list nor the priority inherited by mutexes. Raising the priority keeps a
+         * preemption-threshold higher than `prio`.
+         *
+         * @remark Thread context callable
+         */
+        explicit priority_boost(thread::priority prio, mode m = mode::priority);
+
+        /**
+         * @brief Restores the priority and preemption-threshold of the thread.
+         */
+        ~priority_boost();
+
+        /**
+         * @brief Checks if the guard has changed the thread.
+         */
+        [[nodiscard]] bool isBoosted() const {
+            return boosted;
+        }
+
+    private:
+        priority_boost(const priority_boost &) = delete;
+
+        priority_boost &operator=(const priority_boost &) = delete;
+
+        native::TX_THREAD_STRUCT *thread_ptr{};
+        native::UINT old_priority{};
+        native::UINT old_threshold{};
+        mode m;
+        bool boosted{};
+    };
+
+
+    /**
+     * @class priority_ceiling
+     * @brief Lockable implementing the immediate priority ceiling protocol with the preemption-threshold.
+     *
+     * Locking raises the preemption-threshold of the current thread to the ceiling, so no other thread with
+     * a priority up to the ceiling can run until it is unlocked. If all users of a resource have a priority
+     * lower than or equal to the ceiling, this excludes them from each other without a mutex, without
+     * priority inversion and without a context switch on contention.
+     *
+     * @code
+     * priority_ceiling busLock(4);
+     * std::lock_guard<priority_ceiling> lock(busLock);
+     * @endcode
+     *
+     * @note Threads with a priority higher than the ceiling and ISRs are not locked out.
+     * Threads must not suspend while holding the lock.
+     */
+    class priority_ceiling {
+    public:
+        explicit constexpr priority_ceiling(thread::priority ceiling)
+            : ceiling(ceiling) {
+        }
+
+        /**
+         * @brief Raises the preemption-threshold of the current thread to the ceiling.
+         * @remark Thread context callable
+         */
+        void lock();
+
+        /**
+         * @brief Same as `lock()`, which never blocks.
+         */
+        bool try_lock() {
+            lock();
+            return true;
+        }
+
+        /**
+         * @brief Restores the preemption-threshold of the thread that locked.
+         * @remark Thread context callable
+         */
+        void unlock();
+
+        [[nodiscard]] thread::priority getCeiling() const {
+            return ceiling;
+        }
+
+    private:
+        priority_ceiling(const priority_ceiling &) = delete;
+
+        priority_ceiling &operator=(const priority_ceiling &) = delete;
+
+        thread::priority ceiling;
+        native::TX_THREAD_STRUCT *owner{};
+        native::UINT old_threshold{};
+        bool raised{};
+    };
+
+
+#ifdef TX_EXECUTION_PROFILE_ENABLE
+    /**
+     * @class adaptive_priority
+     * @brief Raises the priority of starving background threads while the CPU is busy.
+     *
+     * Each registered thread gets a minimum load. After each profiler sample, a thread whose load is below
+     * its minimum while the total load is at least the busy load is raised by one priority level, up to its
+     * limit. A thread whose load is back to its minimum, or any thread once the CPU isn't busy anymore,
+     * is lowered by one level, back to the priority it had when it was registered.
+     *
+     * @code
+     * static_adaptive_priority<4> aging;
+     * aging.add(logThread, 8, 200); // at least 2 %, raised up to priority 8
+     * for (;;) {
+     *     profiler.sample();
+     *     aging.update(profiler);
+     *     this_thread::sleepFor(std::chrono::milliseconds(100));
+     * }
+     * @endcode
+     *
+     * @see static_adaptive_priority, profiler
+     */
+    class adaptive_priority {
+    public:
+        using load_type = profiler::load_type;
+
+        /**
+         * @brief Registers a thread.
+         *
+         * @param t The thread, its current priority is the priority it returns to, its current preemption
+         *          threshold is kept across the changes.
+         * @param limit The highest priority the thread is raised to.
+         * @param min_load The load below which the thread is considered starving.
+         * @return true if the thread was registered, false if there is no free entry.
+         */
+        bool add(thread &t, thread::priority limit, load_type min_load);
+
+        /**
+         * @brief Sets the total load from which the CPU is considered busy, 90 % by default.
+         */
+        void setBusyLoad(load_type load) {
+            busy_load = load;
+        }
+
+        /**
+         * @brief Adjusts the priorities of the registered threads to the last sample of the profiler.
+         *
+         * Only threads whose priority changes cost a kernel call, one more if their preemption threshold
+         * has to be restored.
+         *
+         * @remark Thread context callable
+         */
+        void update(const profiler &p);
+
+    protected:
+        struct entry {
+            thread *t;
+            thread::priority base;
+            thread::priority limit;
+            thread::priority threshold;
+            load_type min_load;
+        };
+
+        adaptive_priority(entry *entries, std::size_t capacity)
+            : entries(entries), capacity(capacity) {
+        }
+
+    private:
+        adaptive_priority(const adaptive_priority &) = delete;
+
+        adaptive_priority &operator=(const adaptive_priority &) = delete;
+
+        entry *entries{};
+        std::size_t capacity{};
+        std::size_t count{};
+        load_type busy_load{profiler::FULL_LOAD / 10 * 9};
+    };
+
+    /**
+     * @class static_adaptive_priority
+     * @brief Adaptive priorities with statically allocated storage for `MAX_THREADS` threads.
+     *
+     * @tparam MAX_THREADS The maximum number of registered threads.
+     */
+    template<std::size_t MAX_THREADS>
+    class static_adaptive_priority : public adaptive_priority {
+        static_assert(MAX_THREADS > 0, "MAX_THREADS must be greater than zero");
+
+    public:
+        static_adaptive_priority()
+            : adaptive_priority(entries_, MAX_THREADS) {
+        }
+
+    private:
+        entry entries_[MAX_THREADS]{};
+    };
+#endif // TX_EXECUTION_PROFILE_ENABLE
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXPRIORITY_HPP
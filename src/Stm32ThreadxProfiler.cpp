@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include "Stm32ThreadxProfiler.hpp"
+
+#ifdef TX_EXECUTION_PROFILE_ENABLE
+
+#include "Stm32ThreadxPeriodicTimer.hpp"
+#include "tx_thread.h"
+
+extern "C" {
+#include "tx_execution_profile.h"
+}
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+void profiler::sample() {
+    EXECUTION_TIME idle = 0;
+    EXECUTION_TIME isr = 0;
+    std::uint64_t threads_delta = 0;
+    std::size_t i = 0;
+
+    TX_INTERRUPT_SAVE_AREA
+
+    // the thread list is stable without preemption, see thread::visit(), interrupts are disabled only
+    // around the reads of the counters, which the execution profile updates from the ISR exits
+    TX_DISABLE
+    _tx_thread_preempt_disable = _tx_thread_preempt_disable + 1;
+    _tx_execution_idle_time_get(&idle);
+    _tx_execution_isr_time_get(&isr);
+    TX_RESTORE
+
+    auto *t = _tx_thread_created_ptr;
+    for (ULONG n = 0; n < _tx_thread_created_count && i < capacity; ++n, ++i) {
+        EXECUTION_TIME time = 0;
+        TX_DISABLE
+        _tx_execution_thread_time_get(t, &time);
+        TX_RESTORE
+        auto id = reinterpret_cast<thread::id>(t);
+        auto &e = entries[i];
+        e.delta = (e.id == id) ? time - e.last : 0;
+        e.id = id;
+        e.last = time;
+        threads_delta += e.delta;
+        t = t->tx_thread_created_next;
+    }
+
+    TX_DISABLE
+    _tx_thread_preempt_disable = _tx_thread_preempt_disable - 1;
+    TX_RESTORE
+    _tx_thread_system_preempt_check();
+
+    for (std::size_t j = i; j < capacity; ++j) {
+        entries[j] = entry{};
+    }
+
+    const std::uint64_t idle_delta = idle - last_idle;
+    const std::uint64_t isr_delta = isr - last_isr;
+    last_idle = idle;
+    last_isr = isr;
+    const std::uint64_t total = threads_delta + idle_delta + isr_delta;
+    if (total == 0) {
+        return;
+    }
+    for (std::size_t j = 0; j < i; ++j) {
+        entries[j].load = static_cast<load_type>(entries[j].delta * FULL_LOAD / total);
+    }
+    idle_load = static_cast<load_type>(idle_delta * FULL_LOAD / total);
+    isr_load = static_cast<load_type>(isr_delta * FULL_LOAD / total);
+}
+
+void profiler::run(tick_timer::duration period) {
+    periodic_timer timer(period);
+    for (;;) {
+        timer.wait();
+        sample();
+    }
+}
+
+profiler::load_type profiler::getLoad(thread::id id) const {
+    for (std::size_t i = 0; i < capacity && entries[i].id != 0; ++i) {
+        if (entries[i].id == id) {
+            return entries[i].load;
+        }
+    }
+    return 0;
+}
+
+#endif // TX_EXECUTION_PROFILE_ENABLE
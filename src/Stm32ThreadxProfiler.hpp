@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXPROFILER_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXPROFILER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "tx_api.h"
+#include "Stm32ThreadxThread.hpp"
+
+#ifdef TX_EXECUTION_PROFILE_ENABLE
+
+namespace Stm32ThreadxThread {
+    /**
+     * @class profiler
+     * @brief Computes the CPU load of all threads from the ThreadX execution profile.
+     *
+     * Each call to `sample()` reads the accumulated run time of every created thread, the idle time and the
+     * ISR time, and computes the share of each of them since the previous sample. All threads known to the
+     * kernel are sampled, including threads not created by this library, like the system timer thread.
+     *
+     * Loads are given in hundredths of a percent, `FULL_LOAD` being 100 %.
+     *
+     * @note Requires the kernel to be built with `TX_EXECUTION_PROFILE_ENABLE` and the execution profile kit.
+     *
+     * @see static_profiler
+     */
+    class profiler {
+    public:
+        using load_type = std::uint16_t;
+        static constexpr load_type FULL_LOAD = 10000;
+
+        /**
+         * @brief Takes a sample and updates the loads.
+         *
+         * Threads are matched to the previous sample by their position in the kernel's list of created threads.
+         * After a thread has been created or deleted, the loads of the affected threads are zero for one sample.
+         *
+         * @remark Thread context callable
+         */
+        void sample();
+
+        /**
+         * @brief Samples forever, with the given period.
+         *
+         * Can be used as the body of a dedicated profiler thread.
+         *
+         * @param period The sample period.
+         */
+        [[noreturn]] void run(tick_timer::duration period);
+
+        /**
+         * @brief Get the load of a thread during the last sample period.
+         * @param id The ID of the thread.
+         * @return The load of the thread, zero if the thread is not known.
+         */
+        [[nodiscard]] load_type getLoad(thread::id id) const;
+
+        /**
+         * @brief Get the load of a thread during the last sample period.
+         */
+        [[nodiscard]] load_type getLoad(const thread &t) const {
+            return getLoad(t.getId());
+        }
+
+        /**
+         * @brief Get the time spent in the idle loop during the last sample period.
+         */
+        [[nodiscard]] load_type getIdleLoad() const {
+            return idle_load;
+        }
+
+        /**
+         * @brief Get the time spent in interrupts during the last sample period.
+         */
+        [[nodiscard]] load_type getIsrLoad() const {
+            return isr_load;
+        }
+
+        /**
+         * @brief Get the total CPU load, all but the idle time, during the last sample period.
+         */
+        [[nodiscard]] load_type getTotalLoad() const {
+            return FULL_LOAD - idle_load;
+        }
+
+        /**
+         * @brief Calls `f(thread::id, load_type)` for every thread of the last sample.
+         */
+        template<class F>
+        void forEach(F f) const {
+            for (std::size_t i = 0; i < capacity && entries[i].id != 0; ++i) {
+                f(entries[i].id, entries[i].load);
+            }
+        }
+
+    protected:
+        struct entry {
+            thread::id id;
+            std::uint64_t last;
+            std::uint64_t delta;
+            load_type load;
+        };
+
+        profiler(entry *entries, std::size_t capacity)
+            : entries(entries), capacity(capacity) {
+        }
+
+    private:
+        profiler(const profiler &) = delete;
+
+        profiler &operator=(const profiler &) = delete;
+
+        entry *entries{};
+        std::size_t capacity{};
+        std::uint64_t last_idle{};
+        std::uint64_t last_isr{};
+        load_type idle_load{};
+        load_type isr_load{};
+    };
+
+    /**
+     * @class static_profiler
+     * @brief Profiler with statically allocated storage for `MAX_THREADS` threads.
+     *
+     * @tparam MAX_THREADS The maximum number of threads sampled, further threads are ignored.
+     */
+    template<std::size_t MAX_THREADS>
+    class static_profiler : public profiler {
+        static_assert(MAX_THREADS > 0, "MAX_THREADS must be greater than zero");
+
+    public:
+        static_profiler()
+            : profiler(entries_, MAX_THREADS) {
+        }
+
+    private:
+        entry entries_[MAX_THREADS]{};
+    };
+}
+
+#endif // TX_EXECUTION_PROFILE_ENABLE
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXPROFILER_HPP
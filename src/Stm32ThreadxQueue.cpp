@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include <cassert>
+#include "Stm32ThreadxQueue.hpp"
+#include "Stm32ThreadxConfig.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+void queue::createQueue() {
+    // https://github.com/eclipse-threadx/rtos-docs/blob/main/rtos-docs/threadx/chapter4.md#tx_queue_create
+    STM32THREADXTHREAD_ASSERT(storage != nullptr);
+    STM32THREADXTHREAD_ASSERT(message_words > 0 && message_words <= MAX_MESSAGE_WORDS);
+    auto result = tx_queue_create(
+        this, // TX_QUEUE *queue_ptr
+        const_cast<char *>(name), // CHAR *name_ptr
+        message_words, // UINT message_size
+        storage, // VOID *queue_start
+        storage_size); // ULONG queue_size
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+queue::~queue() {
+    if (!isCreated()) {
+        return;
+    }
+    auto result = tx_queue_delete(this);
+    assert(result == TX_SUCCESS);
+    (void) result;
+}
+
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
+
+void queue::setSendNotify(notify_callback callback, void *context) {
+    send_notify = nullptr;
+    send_notify_context = context;
+    send_notify = callback;
+    auto result = tx_queue_send_notify(this, (callback != nullptr) ? &queue::sendNotifyCallback : nullptr);
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+void queue::sendNotifyCallback(TX_QUEUE *queue_ptr) {
+    auto *self = static_cast<queue *>(queue_ptr);
+    if (self->send_notify != nullptr) {
+        self->send_notify(self->send_notify_context);
+    }
+}
+
+#endif
+
+bool queue::isCreated() const {
+    return tx_queue_id == TX_QUEUE_ID;
+}
@@ -0,0 +1,273 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXQUEUE_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXQUEUE_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "tx_api.h"
+#include "Stm32ThreadxTickTimer.hpp"
+
+namespace Stm32ThreadxThread {
+    namespace native {
+        // these macros may use native type casts, so need some redirection
+        constexpr UINT MAX_MESSAGE_WORDS = TX_16_ULONG;
+        using UINT = UINT;
+        using ULONG = ULONG;
+        using TX_QUEUE = TX_QUEUE;
+    }
+
+    /**
+     * @class queue
+     * @brief Wraps a ThreadX message queue.
+     *
+     * This class manages the kernel object. Messages are sent and received through the typed
+     * interface of `static_queue`.
+     *
+     * @note The queue must be created by calling `createQueue()` before it is used.
+     *
+     * @see static_queue
+     */
+    class queue : private native::TX_QUEUE {
+    public:
+        ~queue();
+
+        /**
+         * @brief Create the queue by calling `tx_queue_create()`.
+         */
+        void createQueue();
+
+        /**
+         * @brief Get the number of messages in the queue.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] native::ULONG getCount() const {
+            return tx_queue_enqueued;
+        }
+
+        /**
+         * @brief Get the number of messages that can still be sent to the queue.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] native::ULONG getAvailable() const {
+            return tx_queue_available_storage;
+        }
+
+        /**
+         * @brief Deletes all messages in the queue.
+         *
+         * Threads suspended because the queue was full are resumed.
+         */
+        void flush() {
+            tx_queue_flush(this);
+        }
+
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
+        using notify_callback = void (*)(void *context);
+
+        /**
+         * @brief Registers a callback called whenever a message is sent to the queue.
+         *
+         * The callback is called from the context of the sender and must not suspend.
+         *
+         * @param callback The callback, nullptr to remove it.
+         * @param context Passed to the callback.
+         *
+         * @see tx_queue_send_notify()
+         */
+        void setSendNotify(notify_callback callback, void *context);
+
+    private:
+        static void sendNotifyCallback(native::TX_QUEUE *queue_ptr);
+
+        notify_callback send_notify{};
+        void *send_notify_context{};
+
+    public:
+#endif // !TX_DISABLE_NOTIFY_CALLBACKS
+
+    protected:
+        static constexpr const char *DEFAULT_NAME = "N/A";
+
+        queue(void *storage, native::ULONG storage_size, native::UINT message_words, const char *name)
+            : TX_QUEUE(), storage(storage), storage_size(storage_size), message_words(message_words), name(name) {
+        }
+
+        bool sendMessage(const void *message, tick_timer::duration rel_time) {
+            return tx_queue_send(this, const_cast<void *>(message), toTicks(rel_time)) == TX_SUCCESS;
+        }
+
+        bool frontSendMessage(const void *message, tick_timer::duration rel_time) {
+            return tx_queue_front_send(this, const_cast<void *>(message), toTicks(rel_time)) == TX_SUCCESS;
+        }
+
+        bool receiveMessage(void *message, tick_timer::duration rel_time) {
+            return tx_queue_receive(this, message, toTicks(rel_time)) == TX_SUCCESS;
+        }
+
+    private:
+        queue(const queue &) = delete;
+
+        queue &operator=(const queue &) = delete;
+
+        [[nodiscard]] bool isCreated() const;
+
+        void *storage{};
+        native::ULONG storage_size{};
+        native::UINT message_words{};
+        const char *name{};
+    };
+
+
+    /**
+     * @class static_queue
+     * @brief Typed message queue with statically allocated storage.
+     *
+     * The ThreadX message size is chosen at compile time as the minimum number of 32-bit words holding a `T`.
+     * If `T` is a multiple of the word size and word aligned, messages are copied by the kernel directly from and
+     * to the caller's object, otherwise they go through a word buffer on the stack.
+     *
+     * Larger objects can be passed by pointer with `static_queue<T *, N>`, e.g. with the pointers
+     * allocated from a `static_block_pool`.
+     *
+     * @tparam T The message type, must be trivially copyable.
+     * @tparam N The capacity of the queue in messages.
+     */
+    template<class T, std::size_t N>
+    class static_queue : public queue {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "T must be trivially copyable, pass it by pointer with static_queue<T *, N> instead");
+        static_assert(sizeof(T) <= native::MAX_MESSAGE_WORDS * sizeof(native::ULONG),
+                      "T is larger than the maximum ThreadX message size of 16 words, "
+                      "pass it by pointer with static_queue<T *, N> instead");
+        static_assert(N > 0, "N must be greater than zero");
+
+    public:
+        using value_type = T;
+        static constexpr std::size_t CAPACITY = N;
+        static constexpr native::UINT MESSAGE_WORDS =
+                (sizeof(T) + sizeof(native::ULONG) - 1) / sizeof(native::ULONG);
+
+        explicit static_queue(const char *name = DEFAULT_NAME)
+            : queue(storage_, sizeof(storage_), MESSAGE_WORDS, name) {
+        }
+
+        /**
+         * @brief Sends a message to the back of the queue, blocks until there is space in the queue.
+         * @remark Thread context callable
+         */
+        void send(const T &item) {
+            sendFor(item, infinity);
+        }
+
+        /**
+         * @brief Sends a message to the back of the queue, blocks until there is space or the timeout expires.
+         * @return true if the message has been sent, false otherwise
+         * @remark Thread context callable, ISR context callable with `rel_time` zero
+         */
+        bool sendFor(const T &item, tick_timer::duration rel_time) {
+            if constexpr (DIRECT_COPY) {
+                return sendMessage(&item, rel_time);
+            } else {
+                message_buffer buffer(item);
+                return sendMessage(buffer.words, rel_time);
+            }
+        }
+
+        /**
+         * @brief Sends a message to the back of the queue without blocking.
+         * @return true if the message has been sent, false if the queue is full
+         * @remark Thread and ISR context callable
+         */
+        bool trySend(const T &item) {
+            return sendFor(item, tick_timer::duration::zero());
+        }
+
+        /**
+         * @brief Sends a message to the front of the queue, blocks until there is space or the timeout expires.
+         * @return true if the message has been sent, false otherwise
+         * @remark Thread context callable, ISR context callable with `rel_time` zero
+         */
+        bool sendFrontFor(const T &item, tick_timer::duration rel_time) {
+            if constexpr (DIRECT_COPY) {
+                return frontSendMessage(&item, rel_time);
+            } else {
+                message_buffer buffer(item);
+                return frontSendMessage(buffer.words, rel_time);
+            }
+        }
+
+        /**
+         * @brief Sends a message to the front of the queue without blocking.
+         * @return true if the message has been sent, false if the queue is full
+         * @remark Thread and ISR context callable
+         */
+        bool trySendFront(const T &item) {
+            return sendFrontFor(item, tick_timer::duration::zero());
+        }
+
+        /**
+         * @brief Receives a message from the queue, blocks until a message is available.
+         * @remark Thread context callable
+         */
+        void receive(T &item) {
+            receiveFor(item, infinity);
+        }
+
+        /**
+         * @brief Receives a message from the queue, blocks until a message is available or the timeout expires.
+         * @return true if a message has been received, false otherwise
+         * @remark Thread context callable, ISR context callable with `rel_time` zero
+         */
+        bool receiveFor(T &item, tick_timer::duration rel_time) {
+            if constexpr (DIRECT_COPY) {
+                return receiveMessage(&item, rel_time);
+            } else {
+                message_buffer buffer;
+                if (!receiveMessage(buffer.words, rel_time)) {
+                    return false;
+                }
+                std::memcpy(&item, buffer.words, sizeof(T));
+                return true;
+            }
+        }
+
+        /**
+         * @brief Receives a message from the queue without blocking.
+         * @return true if a message has been received, false if the queue is empty
+         * @remark Thread and ISR context callable
+         */
+        bool tryReceive(T &item) {
+            return receiveFor(item, tick_timer::duration::zero());
+        }
+
+    private:
+        static constexpr bool DIRECT_COPY = (sizeof(T) == MESSAGE_WORDS * sizeof(native::ULONG)) &&
+                                            (alignof(T) >= alignof(native::ULONG));
+
+        struct message_buffer {
+            message_buffer() = default;
+
+            explicit message_buffer(const T &item) {
+                std::memcpy(words, &item, sizeof(T));
+            }
+
+            native::ULONG words[MESSAGE_WORDS]{};
+        };
+
+        native::ULONG storage_[N * MESSAGE_WORDS]{};
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXQUEUE_HPP
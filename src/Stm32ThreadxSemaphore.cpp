@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include <cassert>
+#include "Stm32ThreadxSemaphore.hpp"
+#include "Stm32ThreadxConfig.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+void semaphore::createSemaphore() {
+    // https://github.com/eclipse-threadx/rtos-docs/blob/main/rtos-docs/threadx/chapter4.md#tx_semaphore_create
+    STM32THREADXTHREAD_ASSERT(initial <= ceiling);
+    auto result = tx_semaphore_create(
+        this, // TX_SEMAPHORE *semaphore_ptr
+        const_cast<char *>(name), // CHAR *name_ptr
+        initial); // ULONG initial_count
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+semaphore::~semaphore() {
+    if (!isCreated()) {
+        return;
+    }
+    auto result = tx_semaphore_delete(this);
+    assert(result == TX_SUCCESS);
+    (void) result;
+}
+
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
+
+void semaphore::setPutNotify(notify_callback callback, void *context) {
+    put_notify = nullptr;
+    put_notify_context = context;
+    put_notify = callback;
+    auto result = tx_semaphore_put_notify(this, (callback != nullptr) ? &semaphore::putNotifyCallback : nullptr);
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+void semaphore::putNotifyCallback(TX_SEMAPHORE *semaphore_ptr) {
+    auto *self = static_cast<semaphore *>(semaphore_ptr);
+    if (self->put_notify != nullptr) {
+        self->put_notify(self->put_notify_context);
+    }
+}
+
+#endif
+
+bool semaphore::isCreated() const {
+    return tx_semaphore_id == TX_SEMAPHORE_ID;
+}
@@ -0,0 +1,205 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXSEMAPHORE_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXSEMAPHORE_HPP
+
+#include <cassert>
+#include <limits>
+#include "tx_api.h"
+#include "Stm32ThreadxTickTimer.hpp"
+
+namespace Stm32ThreadxThread {
+    namespace native {
+        using ULONG = ULONG;
+        using TX_SEMAPHORE = TX_SEMAPHORE;
+    }
+
+    /**
+     * @class semaphore
+     * @brief Wraps a ThreadX counting semaphore.
+     *
+     * The interface follows `std::counting_semaphore`. The count is limited to the ceiling given at construction,
+     * releases above the ceiling are ignored.
+     *
+     * @note The semaphore must be created by calling `createSemaphore()` before it is used.
+     *
+     * @see counting_semaphore, binary_semaphore
+     */
+    class semaphore : private native::TX_SEMAPHORE {
+    public:
+        using count_type = native::ULONG;
+
+        /**
+         * @brief Constructs a semaphore object, without creating the kernel object.
+         *
+         * @param desired The initial count of the semaphore.
+         * @param ceiling The maximum count of the semaphore.
+         * @param name The name of the semaphore.
+         *
+         * @see createSemaphore()
+         */
+        explicit semaphore(count_type desired = 0, count_type ceiling = max(), const char *name = DEFAULT_NAME)
+            : TX_SEMAPHORE(), initial(desired), ceiling(ceiling), name(name) {
+        }
+
+        ~semaphore();
+
+        /**
+         * @brief Create the semaphore by calling `tx_semaphore_create()`.
+         */
+        void createSemaphore();
+
+        /**
+         * @brief The maximum count a semaphore can have.
+         */
+        static constexpr count_type max() {
+            return std::numeric_limits<count_type>::max();
+        }
+
+        /**
+         * @brief Decrements the count of the semaphore, blocks until the count is greater than zero.
+         * @remark Thread context callable
+         */
+        void acquire() {
+            auto result = tx_semaphore_get(this, TX_WAIT_FOREVER);
+            assert(result == TX_SUCCESS);
+            (void) result;
+        }
+
+        /**
+         * @brief Tries to decrement the count of the semaphore without blocking.
+         * @return true if the count has been decremented, false otherwise
+         * @remark Thread and ISR context callable
+         */
+        bool try_acquire() {
+            return tx_semaphore_get(this, TX_NO_WAIT) == TX_SUCCESS;
+        }
+
+        /**
+         * @brief Tries to decrement the count of the semaphore, blocks until the count is greater than zero or
+         * the timeout expires.
+         * @param rel_time The maximum duration to wait.
+         * @return true if the count has been decremented, false otherwise
+         * @remark Thread context callable
+         */
+        bool try_acquire_for(tick_timer::duration rel_time) {
+            return tx_semaphore_get(this, toTicks(rel_time)) == TX_SUCCESS;
+        }
+
+        template<class Rep, class Period>
+        bool try_acquire_for(const std::chrono::duration<Rep, Period> &rel_time) {
+            return try_acquire_for(std::chrono::duration_cast<tick_timer::duration>(rel_time));
+        }
+
+        /**
+         * @brief Tries to decrement the count of the semaphore, blocks until the count is greater than zero or
+         * the deadline is reached.
+         * @param abs_time The deadline.
+         * @return true if the count has been decremented, false otherwise
+         * @remark Thread context callable
+         */
+        template<class Clock, class Duration>
+        bool try_acquire_until(const std::chrono::time_point<Clock, Duration> &abs_time) {
+            const auto now = Clock::now();
+            return (abs_time > now) ? try_acquire_for(abs_time - now) : try_acquire();
+        }
+
+        /**
+         * @brief Increments the count of the semaphore.
+         * @param update The amount to increment the count by.
+         * @remark Thread and ISR context callable
+         */
+        void release(count_type update = 1) {
+            while (update-- > 0) {
+                if (ceiling == max()) {
+                    tx_semaphore_put(this);
+                } else {
+                    tx_semaphore_ceiling_put(this, ceiling);
+                }
+            }
+        }
+
+        /**
+         * @brief Get the current count of the semaphore.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] count_type getCount() const {
+            return tx_semaphore_count;
+        }
+
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
+        using notify_callback = void (*)(void *context);
+
+        /**
+         * @brief Registers a callback called whenever the semaphore is released.
+         *
+         * The callback is called from the context of the releasing thread or ISR and must not suspend.
+         *
+         * @param callback The callback, nullptr to remove it.
+         * @param context Passed to the callback.
+         *
+         * @see tx_semaphore_put_notify()
+         */
+        void setPutNotify(notify_callback callback, void *context);
+
+    private:
+        static void putNotifyCallback(native::TX_SEMAPHORE *semaphore_ptr);
+
+        notify_callback put_notify{};
+        void *put_notify_context{};
+
+    public:
+#endif // !TX_DISABLE_NOTIFY_CALLBACKS
+
+    protected:
+        static constexpr const char *DEFAULT_NAME = "N/A";
+
+    private:
+        semaphore(const semaphore &) = delete;
+
+        semaphore &operator=(const semaphore &) = delete;
+
+        [[nodiscard]] bool isCreated() const;
+
+        count_type initial{};
+        count_type ceiling{};
+        const char *name{};
+    };
+
+    /**
+     * @class counting_semaphore
+     * @brief Semaphore with a compile time maximum count, like `std::counting_semaphore`.
+     *
+     * @tparam LEAST_MAX_VALUE The maximum count of the semaphore.
+     */
+    template<semaphore::count_type LEAST_MAX_VALUE = semaphore::max()>
+    class counting_semaphore : public semaphore {
+        static_assert(LEAST_MAX_VALUE > 0, "LEAST_MAX_VALUE must be greater than zero");
+
+    public:
+        explicit counting_semaphore(count_type desired = 0, const char *name = DEFAULT_NAME)
+            : semaphore(desired, LEAST_MAX_VALUE, name) {
+        }
+
+        static constexpr count_type max() {
+            return LEAST_MAX_VALUE;
+        }
+    };
+
+    /**
+     * @brief Semaphore with a maximum count of one, like `std::binary_semaphore`.
+     */
+    using binary_semaphore = counting_semaphore<1>;
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXSEMAPHORE_HPP
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXSPSCRING_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXSPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Alignment of the producer and consumer indices of `spsc_ring`.
+ *
+ * Keeps the indices in separate cache lines on cores with a data cache, like the Cortex-M7.
+ */
+#ifndef STM32THREADXTHREAD_CACHE_LINE_SIZE
+#define STM32THREADXTHREAD_CACHE_LINE_SIZE 32
+#endif
+
+namespace Stm32ThreadxThread {
+    /**
+     * @class spsc_ring
+     * @brief Lock-free single-producer/single-consumer ring buffer.
+     *
+     * One producer, e.g. a single ISR, and one consumer, e.g. a thread, can access the ring concurrently
+     * without locks or kernel calls. The indices run freely and are masked with `N - 1`, so all `N` elements
+     * can be used.
+     *
+     * @note Several ISRs of different priorities pushing to the same ring are multiple producers and need
+     * their own rings.
+     *
+     * @tparam T The element type.
+     * @tparam N The capacity of the ring, must be a power of two.
+     */
+    template<class T, std::size_t N>
+    class spsc_ring {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+        using index_type = std::uint32_t;
+        static constexpr index_type MASK = N - 1;
+
+    public:
+        using value_type = T;
+
+        static constexpr std::size_t capacity() {
+            return N;
+        }
+
+        /**
+         * @brief Adds an element, producer side.
+         * @return true if the element has been added, false if the ring is full
+         */
+        bool push(const T &item) {
+            bool caught_up;
+            return push(item, caught_up);
+        }
+
+        /**
+         * @brief Adds an element, producer side, and reports whether the consumer may be waiting for it.
+         *
+         * @param item The element to add.
+         * @param caught_up Set to true if the consumer had consumed all previous elements when this one was
+         * published, i.e. the ring went from empty to non-empty and the consumer has to be woken.
+         * @return true if the element has been added, false if the ring is full
+         */
+        bool push(const T &item, bool &caught_up) {
+            const index_type h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) == N) {
+                caught_up = false;
+                return false;
+            }
+            buffer[h & MASK] = item;
+            // sequentially consistent, so either this side sees the consumer caught up, or the consumer sees
+            // the new element before it goes to sleep
+            head.store(h + 1, std::memory_order_seq_cst);
+            caught_up = tail.load(std::memory_order_seq_cst) == h;
+            return true;
+        }
+
+        /**
+         * @brief Removes the oldest element, consumer side.
+         * @return true if an element has been removed, false if the ring is empty
+         */
+        bool pop(T &item) {
+            const index_type t = tail.load(std::memory_order_relaxed);
+            if (t == head.load(std::memory_order_seq_cst)) {
+                return false;
+            }
+            item = buffer[t & MASK];
+            tail.store(t + 1, std::memory_order_seq_cst);
+            return true;
+        }
+
+        /**
+         * @brief Checks if the ring is empty.
+         */
+        [[nodiscard]] bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Get the number of elements in the ring.
+         */
+        [[nodiscard]] std::size_t size() const {
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+        }
+
+    private:
+        alignas(STM32THREADXTHREAD_CACHE_LINE_SIZE) std::atomic<index_type> head{0};
+        alignas(STM32THREADXTHREAD_CACHE_LINE_SIZE) std::atomic<index_type> tail{0};
+        alignas(STM32THREADXTHREAD_CACHE_LINE_SIZE) T buffer[N]{};
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXSPSCRING_HPP
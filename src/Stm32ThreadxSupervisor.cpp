@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include "Stm32ThreadxSupervisor.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+std::size_t supervisor::check() {
+    std::size_t missed = 0;
+    const auto handler = on_miss;
+
+    thread::forEach([&missed, handler](thread &t) {
+        const auto deadline = t.getHeartbeatDeadline();
+        if (deadline == tick_timer::duration::zero()) {
+            return;
+        }
+        // a thread which has finished doesn't beat anymore, it is supervised again once restarted
+        const auto s = t.getState();
+        if (s == thread::state::completed || s == thread::state::terminated) {
+            return;
+        }
+        // read the clock per thread, so it is never older than the heartbeat
+        const auto elapsed = tick_timer::now() - t.getLastHeartbeat();
+        if (elapsed > deadline) {
+            ++missed;
+            if (handler != nullptr) {
+                handler(t, elapsed);
+            }
+        }
+    });
+
+    misses += static_cast<std::uint32_t>(missed);
+    if (missed == 0 && feed != nullptr) {
+        feed();
+    }
+    return missed;
+}
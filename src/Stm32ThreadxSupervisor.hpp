@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXSUPERVISOR_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXSUPERVISOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "Stm32ThreadxThread.hpp"
+
+namespace Stm32ThreadxThread {
+    /**
+     * @class supervisor
+     * @brief Checks the heartbeats of all supervised threads and feeds the watchdog only if all are healthy.
+     *
+     * A thread is supervised once it has a heartbeat deadline set with `thread::setHeartbeatDeadline()`.
+     * A thread misses its deadline if its last `this_thread::heartbeat()` is longer ago than the deadline.
+     * Completed and terminated threads are skipped, they keep their deadline and are supervised again once
+     * restarted.
+     * Each miss is reported to the miss handler, which tells which thread starved before the watchdog resets
+     * the system.
+     *
+     * @code
+     * supervisor watchdog;
+     * watchdog.setFeed([] { HAL_IWDG_Refresh(&hiwdg); });
+     * watchdog.setMissHandler([](thread &t, tick_timer::duration) { log::starved(t.getName()); });
+     * controlThread.setHeartbeatDeadline(std::chrono::milliseconds(20));
+     * // periodically, e.g. from a static_supervisor:
+     * watchdog.check();
+     * @endcode
+     *
+     * @see static_supervisor
+     */
+    class supervisor {
+    public:
+        /**
+         * @brief Called for every thread that missed its deadline.
+         *
+         * Called with preemption disabled, so the handler must not suspend, create or delete threads.
+         *
+         * @param t The thread.
+         * @param elapsed The time since the thread's last heartbeat.
+         */
+        using miss_handler = void (*)(thread &t, tick_timer::duration elapsed);
+
+        /**
+         * @brief Called when all supervised threads are healthy, e.g. to refresh the hardware watchdog.
+         */
+        using feed_function = void (*)();
+
+        supervisor() = default;
+
+        void setMissHandler(miss_handler handler) {
+            on_miss = handler;
+        }
+
+        void setFeed(feed_function feed) {
+            this->feed = feed;
+        }
+
+        /**
+         * @brief Checks all supervised threads, feeds the watchdog if none missed its deadline.
+         *
+         * @return The number of threads that missed their deadline.
+         * @remark Thread context callable
+         */
+        std::size_t check();
+
+        /**
+         * @brief Get the number of misses reported since the supervisor was constructed.
+         */
+        [[nodiscard]] std::uint32_t getMisses() const {
+            return misses;
+        }
+
+    private:
+        supervisor(const supervisor &) = delete;
+
+        supervisor &operator=(const supervisor &) = delete;
+
+        miss_handler on_miss{};
+        feed_function feed{};
+        std::uint32_t misses{};
+    };
+
+
+    /**
+     * @class static_supervisor
+     * @brief Supervisor running its checks periodically on its own thread.
+     *
+     * The thread should have a high priority: if it starves itself, the watchdog isn't fed anymore.
+     *
+     * @tparam STACK_SIZE_BYTES The stack size of the supervisor thread in bytes.
+     */
+    template<std::size_t STACK_SIZE_BYTES>
+    class static_supervisor : public supervisor, public static_thread<STACK_SIZE_BYTES> {
+    public:
+        using priority = thread::priority;
+
+        /**
+         * @brief Constructs the supervisor, without creating its thread.
+         *
+         * @param period The time between two checks, shorter than the watchdog timeout.
+         * @param prio The priority of the supervisor thread.
+         * @param name The name of the supervisor thread.
+         *
+         * @see createSupervisor()
+         */
+        explicit static_supervisor(tick_timer::duration period, priority prio = priority(),
+                                   const char *name = "N/A")
+            : static_thread<STACK_SIZE_BYTES>([this]() { work(); }, prio, name), period(period) {
+        }
+
+        /**
+         * @brief Creates and starts the supervisor thread.
+         */
+        void createSupervisor() {
+            this->createThread();
+            this->resume();
+        }
+
+    private:
+        void work() {
+            auto next = tick_timer::now();
+            for (;;) {
+                check();
+                next += period;
+                this_thread::sleepUntil(next);
+            }
+        }
+
+        tick_timer::duration period;
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXSUPERVISOR_HPP
@@ -20,38 +20,93 @@
  */
 
 #include <cassert>
+#include <cstring>
+#include <limits>
 #include "Stm32ThreadxThread.hpp"
-#include "main.hpp"
+#include "Stm32ThreadxLowPower.hpp"
+#include "Stm32ThreadxConfig.hpp"
+#include "tx_thread.h"
+
+#ifdef TX_EXECUTION_PROFILE_ENABLE
+extern "C" {
+#include "tx_execution_profile.h"
+}
+#endif
 
 using namespace Stm32ThreadxThread;
 using namespace Stm32ThreadxThread::native;
 
+namespace {
+    std::uint32_t next_index = 0;
+}
+
 void thread::createThread() {
     // https://github.com/eclipse-threadx/rtos-docs/blob/main/rtos-docs/threadx/chapter4.md#tx_thread_create
-    assert_param(pstack != nullptr);
-    assert_param(stack_size > 0);
+    STM32THREADXTHREAD_ASSERT(pstack != nullptr);
+    STM32THREADXTHREAD_ASSERT(stack_size > 0);
+    // fill the stack with the pattern used by the kernel's stack checking, to measure the peak usage
+    std::memset(pstack, STACK_FILL, stack_size);
+    name_hash = hashName(name);
+    {
+        TX_INTERRUPT_SAVE_AREA
+        TX_DISABLE
+        index = next_index++;
+        TX_RESTORE
+    }
     auto result = tx_thread_create(
         this, // TX_THREAD *thread_ptr
         const_cast<char *>(name), // CHAR *name_ptr
-        func, // VOID (*entry_function)(ULONG id)
-        param, // ULONG entry_input
+        &thread::entryPoint, // VOID (*entry_function)(ULONG id)
+        static_cast<ULONG>(reinterpret_cast<std::uintptr_t>(this)), // ULONG entry_input
         pstack, // VOID *stack_start
         stack_size, // ULONG stack_size
         prio, // UINT priority
-        prio, // UINT preempt_threshold
-        TX_NO_TIME_SLICE, // ULONG time_slice
+        preempt_threshold, // UINT preempt_threshold
+        time_slice, // ULONG time_slice
         TX_DONT_START); // UINT auto_start
-    assert_param(result == TX_SUCCESS);
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    heartbeat();
+    result = tx_event_flags_create(&events, const_cast<char *>(name));
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
+    result = tx_thread_entry_exit_notify(this, &thread::entryExitCallback);
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+#endif
+
+#ifdef TX_LOW_POWER
+    if (max_wakeup_latency != std::chrono::microseconds::max()) {
+        low_power::updateWakeupLatency();
+    }
+#endif
 }
 
 
 thread::~thread() {
+    deleteThread();
+}
+
+void thread::deleteThread() {
+    if (!isCreated()) {
+        return;
+    }
     if (tx_thread_state != TX_COMPLETED) {
         auto result = tx_thread_terminate(this);
         assert(result == TX_SUCCESS);
+        (void) result;
     }
     auto result = tx_thread_delete(this);
     assert(result == TX_SUCCESS);
+    result = tx_event_flags_delete(&events);
+    assert(result == TX_SUCCESS);
+    (void) result;
+
+#ifdef TX_LOW_POWER
+    if (max_wakeup_latency != std::chrono::microseconds::max()) {
+        low_power::updateWakeupLatency();
+    }
+#endif
 }
 
 
@@ -68,39 +123,149 @@ void thread::terminate() {
 }
 
 void thread::reset() {
-    tx_thread_reset(this);
+    const bool was_reset = tx_thread_reset(this) == TX_SUCCESS;
+    if (was_reset && arena_ptr != nullptr) {
+        arena_ptr->reset();
+    }
+    heartbeat();
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
+    tx_event_flags_set(&events, ~EXIT_FLAG, TX_AND);
+#endif
 }
 
-thread::priority thread::getPriority() const {
-    return tx_thread_user_priority;
+void thread::setPriority(priority prio) {
+    // like tx_thread_priority_change(), which resets the preemption threshold to the new priority
+    this->prio = prio;
+    preempt_threshold = prio;
+    if (isCreated()) {
+        priority::value_type old_prio;
+        tx_thread_priority_change(this, prio, &old_prio);
+    }
 }
 
-void thread::setPriority(priority prio) {
-    priority::value_type old_prio;
-    tx_thread_priority_change(this, prio, &old_prio);
+thread::priority thread::getPreemptThreshold() const {
+    return isCreated() ? priority(tx_thread_user_preempt_threshold) : preempt_threshold;
+}
+
+void thread::setPreemptThreshold(priority threshold) {
+    STM32THREADXTHREAD_ASSERT(threshold <= getPriority());
+    preempt_threshold = threshold;
+    if (isCreated()) {
+        priority::value_type old_threshold;
+        auto result = tx_thread_preemption_change(this, threshold, &old_threshold);
+        STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+        (void) result;
+    }
+}
+
+tick_timer::duration thread::getTimeSlice() const {
+    return tick_timer::duration(isCreated() ? tx_thread_new_time_slice : time_slice);
+}
+
+void thread::setTimeSlice(tick_timer::duration slice) {
+    time_slice = toTicks(slice);
+    if (isCreated()) {
+        ULONG old_time_slice;
+        auto result = tx_thread_time_slice_change(this, time_slice, &old_time_slice);
+        STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+        (void) result;
+    }
+}
+
+void thread::setHeartbeatDeadline(tick_timer::duration deadline) {
+    heartbeat();
+    heartbeat_deadline = toTicks(deadline);
+}
+
+#ifdef TX_LOW_POWER
+
+void thread::setMaxWakeupLatency(std::chrono::microseconds latency) {
+    max_wakeup_latency = latency;
+    if (isCreated()) {
+        low_power::updateWakeupLatency();
+    }
 }
 
+#endif
+
 void thread::setStack(void *stackPointer, const std::uint32_t stackSize) {
-    assert_param(stackPointer != nullptr);
-    assert_param(stackSize > 0);
+    STM32THREADXTHREAD_ASSERT(stackPointer != nullptr);
+    STM32THREADXTHREAD_ASSERT(stackSize > 0);
     pstack = stackPointer;
     stack_size = stackSize;
 }
 
-thread::id thread::getId() const {
-    return id(this);
+thread::stack_usage thread::stackUsage() const {
+    stack_usage usage{stack_size, 0, 0, stack_size};
+    if (!isCreated()) {
+        return usage;
+    }
+
+    const auto *begin = static_cast<const unsigned char *>(pstack);
+    const auto *end = begin + stack_size;
+    const auto *sp = static_cast<const unsigned char *>(
+        (getCurrent() == this) ? __builtin_frame_address(0) : tx_thread_stack_ptr);
+    if (sp >= begin && sp <= end) {
+        usage.used = static_cast<std::size_t>(end - sp);
+    }
+
+    // the stack grows downwards, the untouched part is at the beginning
+    const auto *p = begin;
+    while (p < end && *p == STACK_FILL) {
+        ++p;
+    }
+    usage.peak = static_cast<std::size_t>(end - p);
+    if (usage.peak < usage.used) {
+        usage.peak = usage.used;
+    }
+    usage.headroom = stack_size - usage.peak;
+    return usage;
+}
+
+thread::statistics thread::stats() const {
+    statistics s{};
+    s.run_count = tx_thread_run_count;
+    auto *self = const_cast<TX_THREAD_STRUCT *>(static_cast<const TX_THREAD_STRUCT *>(this));
+#ifdef TX_THREAD_ENABLE_PERFORMANCE_INFO
+    tx_thread_performance_info_get(self,
+                                   &s.resumptions, &s.suspensions,
+                                   &s.solicited_preemptions, &s.interrupt_preemptions, &s.priority_inversions,
+                                   &s.time_slices, &s.relinquishes, &s.timeouts, &s.wait_aborts,
+                                   nullptr);
+#endif
+#ifdef TX_EXECUTION_PROFILE_ENABLE
+    EXECUTION_TIME run_time = 0;
+    _tx_execution_thread_time_get(self, &run_time);
+    s.run_time = run_time;
+#endif
+    (void) self;
+    return s;
+}
+
+#ifdef TX_ENABLE_STACK_CHECKING
+
+thread::stack_error_handler thread::stackErrorHandler = nullptr;
+
+void thread::setStackErrorHandler(stack_error_handler handler) {
+    stackErrorHandler = handler;
+    tx_thread_stack_error_notify(handler != nullptr ? &thread::stackErrorCallback : nullptr);
 }
 
-const char *thread::getName() {
-    return const_cast<const char *>(tx_thread_name);
+void thread::stackErrorCallback(TX_THREAD_STRUCT *thread_ptr) {
+    auto handler = stackErrorHandler;
+    // registered kernel wide, threads not created by this library aren't a thread object
+    if (handler != nullptr && isLibraryThread(thread_ptr)) {
+        handler(*static_cast<thread *>(thread_ptr));
+    }
 }
 
+#endif // TX_ENABLE_STACK_CHECKING
 
 thread::state thread::getState() const {
     state s;
     switch (tx_thread_state) {
         case TX_READY:
-            s = (getCurrent() == this) ? state::running : state::ready;
+            s = (native::currentThread() == this) ? state::running : state::ready;
             break;
         case TX_COMPLETED:
             s = state::completed;
@@ -115,77 +280,151 @@ thread::state thread::getState() const {
     return s;
 }
 
-thread *thread::getCurrent() {
-    return reinterpret_cast<thread *>(tx_thread_identify());
+thread *thread::findByName(const char *name) {
+    if (name == nullptr) {
+        return nullptr;
+    }
+
+    struct search {
+        const char *name;
+        std::uint32_t hash;
+        thread *found;
+    } context{name, hashName(name), nullptr};
+
+    visit([](thread &t, void *ctx) {
+        auto *c = static_cast<search *>(ctx);
+        if (t.name_hash == c->hash && t.name != nullptr && std::strcmp(t.name, c->name) == 0) {
+            c->found = &t;
+            return false;
+        }
+        return true;
+    }, &context);
+    return context.found;
 }
 
-void this_thread::yield() {
-    tx_thread_relinquish();
+std::size_t thread::count() {
+    std::size_t n = 0;
+    forEach([&n](thread &) { ++n; });
+    return n;
 }
 
-thread::id this_thread::getId() {
-    return thread::getCurrent()->getId();
+void thread::visit(visitor visit_thread, void *context) {
+    TX_INTERRUPT_SAVE_AREA
+
+    // threads are created and deleted from thread context only, so the list is stable without preemption
+    TX_DISABLE
+    _tx_thread_preempt_disable = _tx_thread_preempt_disable + 1;
+    TX_RESTORE
+
+    auto *t = _tx_thread_created_ptr;
+    for (ULONG n = _tx_thread_created_count; n > 0; --n) {
+        if (isLibraryThread(t) && !visit_thread(*static_cast<thread *>(t), context)) {
+            break;
+        }
+        t = t->tx_thread_created_next;
+    }
+
+    TX_DISABLE
+    _tx_thread_preempt_disable = _tx_thread_preempt_disable - 1;
+    TX_RESTORE
+    _tx_thread_system_preempt_check();
+}
+
+void thread::entryPoint(ULONG self) {
+    auto *t = reinterpret_cast<thread *>(static_cast<std::uintptr_t>(self));
+    t->func(t->param);
+}
+
+void this_thread::yield() {
+    tx_thread_relinquish();
 }
 
 void this_thread::sleepFor(tick_timer::duration rel_time) {
     auto result = tx_thread_sleep(toTicks(rel_time));
     assert(result == TX_SUCCESS);
+    (void) result;
 }
 
-
-#ifndef TX_DISABLE_NOTIFY_CALLBACKS
-
-void thread::set_entry_exit_callback(entry_exit_callback func, void* param)
-    {
-        if (TX_SUCCESS == tx_thread_entry_exit_notify(this, reinterpret_cast<void(*)(TX_THREAD *, unsigned)>(func)))
-        {
-            // TODO: make sure that tx_user.h contains this:
-            // #define TX_THREAD_USER_EXTENSION     void* entry_exit_param_;
-            entry_exit_param_ = param;
-        }
+bool this_thread::sleepUntil(tick_timer::time_point abs_time) {
+    auto *current = tx_thread_identify();
+    UINT old_threshold = 0;
+    // lock out preemption between reading the clock and suspending
+    const bool locked = (current != nullptr) &&
+                        (tx_thread_preemption_change(current, 0, &old_threshold) == TX_SUCCESS);
+
+    const auto remaining = static_cast<std::make_signed<tick_timer::rep>::type>(
+        toTicks(abs_time) - tx_time_get());
+    if (remaining > 0) {
+        auto result = tx_thread_sleep(static_cast<tick_timer::rep>(remaining));
+        assert(result == TX_SUCCESS);
+        (void) result;
     }
 
-// fun name collision between macro used right above, and member variable used below
-#undef tx_thread_entry_exit_notify
-
-    thread::entry_exit_callback thread::get_entry_exit_callback() const
-    {
-        return reinterpret_cast<entry_exit_callback>(this->tx_thread_entry_exit_notify);
+    if (locked) {
+        tx_thread_preemption_change(current, old_threshold, &old_threshold);
     }
+    return remaining > 0;
+}
 
-    void* thread::get_entry_exit_param() const
-    {
-        return this->entry_exit_param_;
+bool this_thread::sleepUntil(tick_timer64::time_point abs_time) {
+    constexpr tick_timer64::duration max_step{std::numeric_limits<tick_timer::rep>::max() / 2};
+    if (abs_time <= tick_timer64::now()) {
+        return false;
+    }
+    while (abs_time - tick_timer64::now() > max_step) {
+        sleepFor(tick_timer::duration(static_cast<tick_timer::rep>(max_step.count())));
     }
+    return sleepUntil(tick_timer::time_point(tick_timer::duration(static_cast<tick_timer::rep>(toTicks(abs_time)))));
+}
 
-    bool thread::joinable() const
-    {
-        auto state = get_state();
-        return (state != state::completed) && (state != state::terminated) && (nullptr == get_entry_exit_param());
+bool this_thread::notifyWaitFor(tick_timer::duration rel_time, thread::notify_flag mask,
+                                thread::notify_flag *received) {
+    auto *current = thread::getCurrent();
+    STM32THREADXTHREAD_ASSERT(current != nullptr);
+    STM32THREADXTHREAD_ASSERT((mask & thread::NOTIFY_ALL) != 0);
+
+    ULONG actual_flags = 0;
+    const bool got = tx_event_flags_get(&current->events, mask & thread::NOTIFY_ALL, TX_OR_CLEAR,
+                                        &actual_flags, toTicks(rel_time)) == TX_SUCCESS;
+    if (received != nullptr) {
+        *received = got ? (actual_flags & mask & thread::NOTIFY_ALL) : 0;
     }
+    return got;
+}
 
-    void thread::join_exit_callback(thread *t, UINT id)
-    {
-        if (id == TX_THREAD_EXIT)
-        {
-            auto *exit_cond = reinterpret_cast<semaphore*>(t->get_entry_exit_param());
 
-            exit_cond->release();
-        }
-    }
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
 
-    void thread::join()
-    {
-        assert(joinable()); // else invalid_argument
-        assert(this->get_id() != this_thread::get_id()); // else resource_deadlock_would_occur
+void thread::join() {
+    auto joined = joinFor(infinity);
+    STM32THREADXTHREAD_ASSERT(joined);
+    (void) joined;
+}
 
-        binary_semaphore exit_cond;
-        set_entry_exit_callback(&thread::join_exit_callback, reinterpret_cast<void*>(&exit_cond));
+bool thread::joinFor(tick_timer::duration rel_time) {
+    STM32THREADXTHREAD_ASSERT(isCreated()); // else invalid_argument
+    STM32THREADXTHREAD_ASSERT(getCurrent() != this); // else resource_deadlock_would_occur
 
-        // wait for signal from thread exit
-        exit_cond.acquire();
+    // wait for signal from thread exit, the flag stays set for further joins
+    ULONG actual_flags;
+    return tx_event_flags_get(&events, EXIT_FLAG, TX_OR, &actual_flags, toTicks(rel_time)) == TX_SUCCESS;
+}
 
-        // signal received, thread is deleted, return
+bool thread::joinable() const {
+    if (!isCreated()) {
+        return false;
     }
+    auto s = getState();
+    return (s != state::completed) && (s != state::terminated);
+}
+
+void thread::entryExitCallback(TX_THREAD_STRUCT *thread_ptr, UINT id) {
+    auto *t = static_cast<thread *>(thread_ptr);
+    if (id == TX_THREAD_EXIT) {
+        tx_event_flags_set(&t->events, EXIT_FLAG, TX_OR);
+    } else {
+        tx_event_flags_set(&t->events, ~EXIT_FLAG, TX_AND);
+    }
+}
 
 #endif // !TX_DISABLE_NOTIFY_CALLBACKS
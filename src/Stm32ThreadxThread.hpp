@@ -22,10 +22,17 @@
 #ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXTHREAD_HPP
 #define LIBSMART_STM32THREADXTHREAD_STM32THREADXTHREAD_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 #include "tx_api.h"
+#ifdef STM32THREADXTHREAD_DIRECT_CURRENT_THREAD
+#include "tx_thread.h"
+#endif
 #include "Stm32ThreadxTickTimer.hpp"
+#include "Stm32ThreadxInlineFunction.hpp"
+#include "Stm32ThreadxArena.hpp"
 
 namespace Stm32ThreadxThread {
     /**
@@ -55,14 +62,78 @@ namespace Stm32ThreadxThread {
 
 #define BOUNCE(c, m) bounce<c, decltype(&c::m), &c::m>
 
+/**
+ * @brief Places a variable in the given linker section.
+ *
+ * Can be used to place a `static_thread` or a `thread_stack` in fast memory, like CCM RAM on STM32F4 or
+ * DTCM on Cortex-M7, so that stack accesses run without wait states:
+ *
+ * @code
+ * STM32THREADXTHREAD_SECTION(".ccmram") static_thread<2048> controlThread(controlLoop, 0, 2, "control");
+ * @endcode
+ *
+ * @note The section must be provided by the linker script, and the memory must be accessible by every bus master
+ * using data on the stack. E.g. CCM RAM can't be accessed by DMA.
+ */
+#ifndef STM32THREADXTHREAD_SECTION
+#define STM32THREADXTHREAD_SECTION(name) __attribute__((section(name)))
+#endif
+
     namespace native {
         // these macros may use native type casts, so need some redirection
         constexpr UINT TOP_PRIORITY = TX_MAX_PRIORITIES;
         constexpr ULONG MIN_STACK_SIZE = TX_TIMER_THREAD_STACK_SIZE;
         constexpr UINT THREAD_EXIT_ID = TX_THREAD_EXIT;
+        constexpr ULONG NO_TIME_SLICE = TX_NO_TIME_SLICE;
+        constexpr unsigned char STACK_FILL = static_cast<unsigned char>(TX_STACK_FILL);
+        constexpr ULONG THREAD_ID = TX_THREAD_ID;
+        constexpr UINT READY = TX_READY;
+        constexpr UINT COMPLETED = TX_COMPLETED;
+        constexpr UINT TERMINATED = TX_TERMINATED;
         using UINT = UINT;
         using ULONG = ULONG;
         using TX_THREAD_STRUCT = TX_THREAD_STRUCT;
+        using TX_EVENT_FLAGS_GROUP = TX_EVENT_FLAGS_GROUP;
+
+        /**
+         * @brief Get the kernel's current thread, nullptr outside of a thread.
+         *
+         * Reads the kernel's current thread pointer directly if `STM32THREADXTHREAD_DIRECT_CURRENT_THREAD` is
+         * defined, which saves the call to `tx_thread_identify()` without relying on LTO.
+         */
+        inline TX_THREAD_STRUCT *currentThread() {
+#ifdef STM32THREADXTHREAD_DIRECT_CURRENT_THREAD
+            TX_THREAD_STRUCT *current;
+            TX_THREAD_GET_CURRENT(current)
+            return current;
+#else
+            return tx_thread_identify();
+#endif
+        }
+    }
+
+#ifdef STM32THREADXTHREAD_TLS_SLOTS
+    /**
+     * @struct tls_key
+     * @brief Base of the key types of thread-local storage slots.
+     *
+     * Each subsystem declares its key with a distinct slot, e.g. `struct log_key : tls_key<0> {};`.
+     * The slots are allocated at compile time, reading a slot costs a single load from the current thread's
+     * control block.
+     *
+     * @tparam SLOT The index of the slot, lower than `STM32THREADXTHREAD_TLS_SLOTS`.
+     *
+     * @see Stm32ThreadxUserExtension.h
+     */
+    template<std::size_t SLOT>
+    struct tls_key {
+        static_assert(SLOT < STM32THREADXTHREAD_TLS_SLOTS, "SLOT must be lower than STM32THREADXTHREAD_TLS_SLOTS");
+        static constexpr std::size_t slot = SLOT;
+    };
+#endif
+
+    namespace this_thread {
+        bool notifyWaitFor(tick_timer::duration rel_time, native::ULONG mask, native::ULONG *received);
     }
 
     /**
@@ -133,6 +204,7 @@ namespace Stm32ThreadxThread {
          * This function resets the specified thread by calling the _txe_thread_reset function with the thread pointer as a parameter.
          *
          * @note This function resets the thread by clearing its internal data structures and returning it to its initial state.
+         * The arena of the thread, if any, is reset as well.
          */
         void reset();
 
@@ -143,8 +215,11 @@ namespace Stm32ThreadxThread {
          * which is a typedef for `std::uintptr_t`.
          *
          * @return The ID of the thread.
+         * @remark Thread and ISR context callable
          */
-        [[nodiscard]] id getId() const;
+        [[nodiscard]] id getId() const {
+            return id(this);
+        }
 
         /**
          * @brief Returns the name of the thread.
@@ -153,8 +228,11 @@ namespace Stm32ThreadxThread {
          * The name can be set using the `setName()` function.
          *
          * @return The name of the thread.
+         * @remark Thread and ISR context callable
          */
-        const char *getName();
+        [[nodiscard]] const char *getName() const {
+            return tx_thread_name;
+        }
 
         /**
          * @enum state
@@ -184,14 +262,118 @@ namespace Stm32ThreadxThread {
          */
         [[nodiscard]] state getState() const;
 
+        /**
+         * @brief Get the scheduling state of the thread, without distinguishing running from ready.
+         *
+         * Cheaper than `getState()`, because the current thread isn't looked up. A running thread is reported
+         * as `state::ready`.
+         *
+         * @return The state of the thread, never `state::running`.
+         * @remark Thread and ISR context callable
+         *
+         * @see getState()
+         */
+        [[nodiscard]] state getSchedulingState() const {
+            switch (tx_thread_state) {
+                case native::READY:
+                    return state::ready;
+                case native::COMPLETED:
+                    return state::completed;
+                case native::TERMINATED:
+                    return state::terminated;
+                default:
+                    return state::suspended;
+            }
+        }
+
         /**
          * @brief Gets a pointer to the current thread object.
          *
          * This function returns a pointer to the current thread object.
          *
-         * @return A pointer to the current thread object.
+         * @return A pointer to the current thread object, nullptr if called from outside of a thread
+         * or from a thread that has not been created by this library.
+         * @remark Thread and ISR context callable
+         *
+         * @note With `STM32THREADXTHREAD_DIRECT_CURRENT_THREAD` defined, the kernel's current thread pointer is read
+         * directly instead of calling `tx_thread_identify()`.
+         */
+        static thread *getCurrent() {
+            auto *current = native::currentThread();
+            return isLibraryThread(current) ? static_cast<thread *>(current) : nullptr;
+        }
+
+        /**
+         * @brief Calls `f(thread &)` for every created thread of this library.
+         *
+         * The kernel's list of created threads is walked in creation order, threads not created by this library
+         * (like the system timer thread) are skipped. Preemption is disabled during the walk,
+         * interrupts are not.
+         *
+         * @note `f` must not suspend, create or delete threads.
+         * @remark Thread context callable
+         */
+        template<class F>
+        static void forEach(F f) {
+            visit([](thread &t, void *context) {
+                (*static_cast<F *>(context))(t);
+                return true;
+            }, &f);
+        }
+
+        /**
+         * @brief Finds a created thread of this library by its name.
+         *
+         * The hash of the name is calculated once when the thread is created, so the lookup compares
+         * the strings only for threads with a matching hash.
+         *
+         * @param name The name of the thread.
+         * @return Pointer to the first thread with the given name, nullptr if there is none or name is nullptr.
+         * @remark Thread context callable
+         */
+        static thread *findByName(const char *name);
+
+        /**
+         * @brief Get the number of created threads of this library.
+         * @remark Thread context callable
          */
-        static thread *getCurrent();
+        static std::size_t count();
+
+        /**
+         * @brief Get the creation index of the thread.
+         *
+         * Every call to `createThread()` assigns the next index, starting at zero. Unlike the ID, the index is
+         * dense, so it can be used to distribute threads over per-thread data.
+         *
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] std::uint32_t getIndex() const {
+            return index;
+        }
+
+        /**
+         * @brief Get the arena of the thread.
+         *
+         * @return The arena, nullptr if the thread has none.
+         *
+         * @see static_thread, this_thread::arena()
+         */
+        [[nodiscard]] arena *getArena() const {
+            return arena_ptr;
+        }
+
+        /**
+         * @brief Calculates the hash of a thread name, as used by `findByName()`.
+         *
+         * 32-bit FNV-1a hash of the null-terminated string.
+         */
+        static constexpr std::uint32_t hashName(const char *name) {
+            std::uint32_t hash = 2166136261UL;
+            while (name != nullptr && *name != '\0') {
+                hash = (hash ^ static_cast<unsigned char>(*name++)) * 16777619UL;
+            }
+            return hash;
+        }
 
         /**
          * @class priority
@@ -240,7 +422,9 @@ namespace Stm32ThreadxThread {
          *
          * @see thread::priority
          */
-        [[nodiscard]] priority getPriority() const;
+        [[nodiscard]] priority getPriority() const {
+            return isCreated() ? priority(tx_thread_user_priority) : prio;
+        }
 
         /**
          * @brief Set the priority of the thread.
@@ -249,6 +433,10 @@ namespace Stm32ThreadxThread {
          * The new priority is used to update the thread's priority using the `_txe_thread_priority_change()` function.
          *
          * @note The thread's priority can range from the minimum priority value (0) to the maximum priority value (native::TOP_PRIORITY).
+         * Like `tx_thread_priority_change()`, this also resets the preemption-threshold to the new priority,
+         * also if the thread is not created yet, so a threshold set before with `setPreemptThreshold()` is lost.
+         * Set the threshold after the priority. If the thread is not created yet, the values are stored and used
+         * by `createThread()`.
          *
          * @param prio The new priority value for the thread.
          *
@@ -256,6 +444,59 @@ namespace Stm32ThreadxThread {
          */
         void setPriority(priority prio);
 
+        /**
+         * @brief Get the preemption-threshold of the thread.
+         *
+         * Only threads with a priority higher (numerically lower) than the preemption-threshold may preempt this thread.
+         * A threshold equal to the thread's priority disables preemption-threshold scheduling.
+         *
+         * @return The preemption-threshold of the thread.
+         *
+         * @see setPreemptThreshold()
+         */
+        [[nodiscard]] priority getPreemptThreshold() const;
+
+        /**
+         * @brief Set the preemption-threshold of the thread.
+         *
+         * If the thread is already created, the threshold is changed using `tx_thread_preemption_change()`.
+         * Otherwise the value is stored and used by `createThread()`.
+         *
+         * @note The threshold must be higher (numerically lower) than or equal to the thread's priority.
+         * Giving a group of cooperating threads a common threshold prevents them from preempting each other,
+         * which reduces the number of context switches between them.
+         *
+         * @param threshold The new preemption-threshold for the thread.
+         *
+         * @see getPreemptThreshold(), tx_thread_preemption_change()
+         */
+        void setPreemptThreshold(priority threshold);
+
+        /**
+         * @brief Get the time-slice of the thread.
+         *
+         * @return The time-slice of the thread, `tick_timer::duration::zero()` if time-slicing is disabled.
+         *
+         * @see setTimeSlice()
+         */
+        [[nodiscard]] tick_timer::duration getTimeSlice() const;
+
+        /**
+         * @brief Set the time-slice of the thread.
+         *
+         * The time-slice is the maximum time the thread runs before other ready threads of the same priority get a
+         * chance to run (round-robin scheduling). A value of `tick_timer::duration::zero()` disables time-slicing.
+         * If the thread is already created, the time-slice is changed using `tx_thread_time_slice_change()`.
+         * Otherwise the value is stored and used by `createThread()`.
+         *
+         * @note Time-slicing has no effect if preemption-threshold scheduling is used for the thread.
+         *
+         * @param slice The new time-slice for the thread.
+         *
+         * @see getTimeSlice(), tx_thread_time_slice_change()
+         */
+        void setTimeSlice(tick_timer::duration slice);
+
         /**
          * @brief Sets the stack pointer and size for the thread.
          *
@@ -266,37 +507,293 @@ namespace Stm32ThreadxThread {
          */
         void setStack(void *stackPointer, std::uint32_t stackSize);
 
+        /**
+         * @struct stack_usage
+         * @brief Snapshot of the stack usage of a thread, in bytes.
+         */
+        struct stack_usage {
+            std::size_t size; ///< Total size of the stack
+            std::size_t used; ///< Currently used, as of the last context save or the caller's frame for the current thread
+            std::size_t peak; ///< Highest usage since the thread was created
+            std::size_t headroom; ///< Never used part of the stack, `size - peak`
+        };
+
+        /**
+         * @brief Get the stack usage of the thread.
+         *
+         * The stack is filled with a pattern by `createThread()`. The peak usage is found by scanning
+         * the stack from its far end for the first byte that is no longer equal to the pattern, so the cost of
+         * this call grows with the headroom of the stack.
+         *
+         * @return The stack usage of the thread.
+         */
+        [[nodiscard]] stack_usage stackUsage() const;
+
+        /**
+         * @struct statistics
+         * @brief Runtime statistics of a thread.
+         *
+         * The counters except `run_count` are only available if the kernel is built with
+         * `TX_THREAD_ENABLE_PERFORMANCE_INFO`, `run_time` only if it is built with `TX_EXECUTION_PROFILE_ENABLE`.
+         * Unavailable values are zero.
+         */
+        struct statistics {
+            native::ULONG run_count; ///< Number of times the thread was scheduled
+            native::ULONG resumptions; ///< Number of resumptions
+            native::ULONG suspensions; ///< Number of suspensions
+            native::ULONG solicited_preemptions; ///< Number of preemptions caused by a service call
+            native::ULONG interrupt_preemptions; ///< Number of preemptions caused by an interrupt
+            native::ULONG priority_inversions; ///< Number of priority inversions
+            native::ULONG time_slices; ///< Number of expired time-slices
+            native::ULONG relinquishes; ///< Number of relinquishes
+            native::ULONG timeouts; ///< Number of suspension timeouts
+            native::ULONG wait_aborts; ///< Number of aborted suspensions
+            std::uint64_t run_time; ///< Accumulated run time in execution profile timer ticks
+        };
+
+        /**
+         * @brief Get the runtime statistics of the thread.
+         *
+         * @return The runtime statistics of the thread.
+         *
+         * @see tx_thread_info_get(), tx_thread_performance_info_get()
+         */
+        [[nodiscard]] statistics stats() const;
+
+#ifdef TX_ENABLE_STACK_CHECKING
+        using stack_error_handler = void (*)(thread &t);
+
+        /**
+         * @brief Registers a handler called by the kernel when it detects a stack overflow in a thread of this
+         * library.
+         *
+         * The callback is registered for all threads using `tx_thread_stack_error_notify()`, stack errors of
+         * threads not created by this library, e.g. the timer thread, are ignored.
+         * It is called from the context of the thread detecting the error.
+         *
+         * @param handler The handler to register, nullptr to remove the handler.
+         */
+        static void setStackErrorHandler(stack_error_handler handler);
+
+    private:
+        static void stackErrorCallback(native::TX_THREAD_STRUCT *thread_ptr);
+
+        static stack_error_handler stackErrorHandler;
+
+    public:
+#endif // TX_ENABLE_STACK_CHECKING
+
+        /**
+         * @brief Registers the thread for supervision, with the maximum time between two heartbeats.
+         *
+         * The thread has to call `this_thread::heartbeat()` at least once per `deadline`, otherwise a
+         * `supervisor` reports it as missed. Setting the deadline counts as a heartbeat. The thread isn't
+         * supervised while it is completed or terminated.
+         *
+         * @param deadline The maximum time between two heartbeats, `tick_timer::duration::zero()` to unregister.
+         *
+         * @see supervisor, this_thread::heartbeat()
+         */
+        void setHeartbeatDeadline(tick_timer::duration deadline);
+
+        /**
+         * @brief Registers the thread for supervision, with the maximum time between two heartbeats.
+         *
+         * @tparam Rep The type representing the number of ticks in the duration.
+         * @tparam Period The ratio representing the tick period.
+         */
+        template<class Rep, class Period>
+        void setHeartbeatDeadline(const std::chrono::duration<Rep, Period> &deadline) {
+            setHeartbeatDeadline(std::chrono::duration_cast<tick_timer::duration>(deadline));
+        }
+
+        /**
+         * @brief Get the maximum time between two heartbeats, zero if the thread isn't supervised.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] tick_timer::duration getHeartbeatDeadline() const {
+            return tick_timer::duration(heartbeat_deadline);
+        }
+
+        /**
+         * @brief Signals that the thread is alive.
+         *
+         * A single relaxed store of the current tick count, no kernel call and no lock.
+         *
+         * @remark Thread and ISR context callable
+         * @see this_thread::heartbeat()
+         */
+        void heartbeat() {
+            last_heartbeat.store(tx_time_get(), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the time of the last heartbeat.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] tick_timer::time_point getLastHeartbeat() const {
+            return tick_timer::time_point(tick_timer::duration(last_heartbeat.load(std::memory_order_relaxed)));
+        }
+
+#ifdef TX_LOW_POWER
+        /**
+         * @brief Declares the maximum wakeup latency the thread tolerates.
+         *
+         * The tickless idle engine only enters sleep depths whose exit latency is within the minimum
+         * tolerated by all created threads. Threads without a declared latency don't limit the sleep depth.
+         *
+         * @param latency The maximum tolerated latency, `std::chrono::microseconds::max()` for no limit.
+         *
+         * @see low_power
+         */
+        void setMaxWakeupLatency(std::chrono::microseconds latency);
+
+        /**
+         * @brief Get the maximum wakeup latency the thread tolerates.
+         */
+        [[nodiscard]] std::chrono::microseconds getMaxWakeupLatency() const {
+            return max_wakeup_latency;
+        }
+#endif // TX_LOW_POWER
+
+#ifdef STM32THREADXTHREAD_TLS_SLOTS
+        /**
+         * @brief Sets a thread-local storage slot of the thread.
+         *
+         * @note The kernel clears the control block when the thread is created, so slots have to be set
+         * after `createThread()`.
+         *
+         * @tparam Key The key of the slot, derived from `tls_key`.
+         * @see this_thread::tls()
+         */
+        template<class Key, class T>
+        void setTls(T *value) {
+            tx_thread_tls_slots[Key::slot] = value;
+        }
+
+        /**
+         * @brief Get a thread-local storage slot of the thread.
+         * @tparam T The type of the object in the slot.
+         * @tparam Key The key of the slot, derived from `tls_key`.
+         */
+        template<class T, class Key>
+        [[nodiscard]] T *getTls() const {
+            return static_cast<T *>(tx_thread_tls_slots[Key::slot]);
+        }
+#endif // STM32THREADXTHREAD_TLS_SLOTS
+
 #ifndef TX_DISABLE_NOTIFY_CALLBACKS
 
-        private:
-            using entry_exit_callback = void (*)(thread*, native::UINT id);
+        /**
+         * @brief Waits for the thread to finish execution.
+         *
+         * The calling thread is suspended on an event flags group embedded in the thread object, which is set by
+         * the thread's entry/exit notification when the thread completes or is terminated.
+         * No memory is allocated and no modification of `tx_user.h` is needed.
+         *
+         * @note May only be called for a created thread, and not from the owned thread's context.
+         *
+         * @see joinFor(), joinable()
+         */
+        void join();
 
-            void set_entry_exit_callback(entry_exit_callback func, void* param);
-            entry_exit_callback get_entry_exit_callback() const;
-            void* get_entry_exit_param() const;
-            static void join_exit_callback(thread *t, native::UINT id);
+        /**
+         * @brief Waits for the thread to finish execution, for a limited time.
+         *
+         * @param rel_time The maximum duration to wait.
+         * @return true if the thread has finished execution, false if the timeout expired.
+         *
+         * @note May only be called for a created thread, and not from the owned thread's context.
+         *
+         * @see join()
+         */
+        bool joinFor(tick_timer::duration rel_time);
 
-        public:
-            /// @brief  Waits for the thread to finish execution.
-            /// @note   May only be called when the thread is joinable, and not from the owned thread's context
-            void join();
+        /**
+         * @brief Waits for the thread to finish execution, for a limited time.
+         *
+         * @tparam Rep The type representing the number of ticks in the duration.
+         * @tparam Period The ratio representing the tick period.
+         *
+         * @param rel_time The maximum duration to wait.
+         * @return true if the thread has finished execution, false if the timeout expired.
+         */
+        template<class Rep, class Period>
+        bool joinFor(const std::chrono::duration<Rep, Period> &rel_time) {
+            return joinFor(std::chrono::duration_cast<tick_timer::duration>(rel_time));
+        }
+
+        /**
+         * @brief Checks if the thread is joinable (potentially executing).
+         *
+         * @return true if the thread is created and has neither completed nor been terminated, false otherwise
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] bool joinable() const;
 
-            /// @brief  Checks if the thread is joinable (potentially executing).
-            /// @return true if the thread is valid and hasn't been joined, false otherwise
-            /// @remark Thread and ISR context callable
-            bool joinable() const;
+    private:
+        static void entryExitCallback(native::TX_THREAD_STRUCT *thread_ptr, native::UINT id);
 
+    public:
 #endif // !TX_DISABLE_NOTIFY_CALLBACKS
 
+        using notify_flag = native::ULONG;
+
+        /**
+         * @brief The notification flags available to the application, the highest bit is used by `join()`.
+         */
+        static constexpr notify_flag NOTIFY_ALL = 0x7FFFFFFFUL;
+
+        /**
+         * @brief Sends notification flags to the thread.
+         *
+         * The flags are ORed into the thread's notification word, which lives in the event flags group embedded
+         * in the thread object. If the thread waits in `this_thread::notifyWaitFor()` for one of the flags, it is
+         * woken up. So a thread is signaled with a single kernel call, without a semaphore or queue per pair of
+         * sender and receiver.
+         *
+         * @param flags The flags to set, bits outside of `NOTIFY_ALL` are ignored.
+         * @note May only be called for a created thread.
+         * @remark Thread and ISR context callable
+         *
+         * @see this_thread::notifyWaitFor()
+         */
+        void notify(notify_flag flags) {
+            tx_event_flags_set(&events, flags & NOTIFY_ALL, TX_OR);
+        }
+
+        /**
+         * @brief Get the pending notification flags of the thread, without clearing them.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] notify_flag getNotifications() const {
+            return events.tx_event_flags_group_current & NOTIFY_ALL;
+        }
+
     protected:
         static constexpr const char *DEFAULT_NAME = "N/A";
         static constexpr size_t DEFAULT_STACK_SIZE = native::MIN_STACK_SIZE;
 
+        /**
+         * @brief Terminates and deletes the thread, if it is created.
+         *
+         * Called by the destructor. Derived classes call it from their own destructor when members used by
+         * the running thread are destroyed before the base class.
+         */
+        void deleteThread();
+
+        /**
+         * @brief Assigns the arena returned by `getArena()` and reset by `reset()`.
+         */
+        void setArena(arena *a) {
+            arena_ptr = a;
+        }
+
         thread(void *pstack, std::uint32_t stack_size,
                threadEntry func, native::ULONG param,
                priority prio, const char *name) : TX_THREAD_STRUCT(), pstack(pstack), stack_size(stack_size), func(func),
                                                   param(param),
-                                                  prio(prio), name(name) {
+                                                  prio(prio), preempt_threshold(prio), name(name) {
         }
 
         thread(threadEntry func, native::ULONG param,
@@ -312,12 +809,56 @@ namespace Stm32ThreadxThread {
 
         thread &operator=(const thread &&) = delete;
 
+        /**
+         * @brief Checks if the thread has been created by `createThread()` and not yet deleted.
+         */
+        [[nodiscard]] bool isCreated() const {
+            return tx_thread_id == native::THREAD_ID;
+        }
+
+        using visitor = bool (*)(thread &t, void *context);
+
+        /**
+         * @brief Walks the kernel's list of created threads, until `visit_thread` returns false.
+         */
+        static void visit(visitor visit_thread, void *context);
+
+        /**
+         * @brief Common entry function of all threads of this library.
+         *
+         * The kernel passes the thread object as entry input, which identifies threads created by this library.
+         */
+        static void entryPoint(native::ULONG self);
+
+        static bool isLibraryThread(const native::TX_THREAD_STRUCT *thread_ptr) {
+            return (thread_ptr != nullptr) && (thread_ptr->tx_thread_entry == &thread::entryPoint);
+        }
+
+        /**
+         * @brief Set in `events` when the thread has completed or has been terminated.
+         */
+        static constexpr native::ULONG EXIT_FLAG = ~NOTIFY_ALL;
+
+        friend bool this_thread::notifyWaitFor(tick_timer::duration rel_time, notify_flag mask,
+                                               notify_flag *received);
+
         void *pstack{};
         std::uint32_t stack_size{};
         threadEntry func{};
         native::ULONG param{};
         priority prio{};
+        priority preempt_threshold{};
+        native::ULONG time_slice{native::NO_TIME_SLICE};
         const char *name{};
+        std::uint32_t name_hash{};
+        std::uint32_t index{};
+        arena *arena_ptr{};
+        std::atomic<native::ULONG> last_heartbeat{};
+        native::ULONG heartbeat_deadline{};
+        native::TX_EVENT_FLAGS_GROUP events{};
+#ifdef TX_LOW_POWER
+        std::chrono::microseconds max_wakeup_latency{std::chrono::microseconds::max()};
+#endif
     };
 
 
@@ -326,67 +867,151 @@ namespace Stm32ThreadxThread {
      * @brief Class for creating and managing static threads.
      *
      * This class extends the `thread` class and provides functionality to create and manage static threads in the application.
-     * It allows creating threads with a fixed stack size and provides constructors for various types of entry functions.
+     * It allows creating threads with a fixed stack size and provides constructors for various types of entry functions,
+     * including any callable stored inline in the object.
      * The stack size is defined by the template parameter `STACK_SIZE_BYTES`.
      *
      * @tparam STACK_SIZE_BYTES The size of the stack in bytes.
+     * @tparam STACK_ALIGNMENT The alignment of the stack in bytes, at least 8 as required by the AAPCS.
+     * @tparam CALLABLE_SIZE_BYTES The size of the inline buffer for a callable entry in bytes.
+     * @tparam ARENA_SIZE_BYTES The size of the thread's arena in bytes, 0 for no arena.
      */
-    template<const std::size_t STACK_SIZE_BYTES>
-    class static_thread : public thread {
+    template<const std::size_t STACK_SIZE_BYTES, const std::size_t STACK_ALIGNMENT = 8,
+        const std::size_t CALLABLE_SIZE_BYTES = 4 * sizeof(void *), const std::size_t ARENA_SIZE_BYTES = 0>
+    class static_thread : public thread, private detail::thread_arena<ARENA_SIZE_BYTES> {
+        static_assert(STACK_ALIGNMENT >= 8, "STACK_ALIGNMENT must be at least 8 bytes");
+        static_assert((STACK_ALIGNMENT & (STACK_ALIGNMENT - 1)) == 0, "STACK_ALIGNMENT must be a power of two");
+
     public:
         static constexpr std::size_t STACK_SIZE = STACK_SIZE_BYTES;
+        static constexpr std::size_t CALLABLE_SIZE = CALLABLE_SIZE_BYTES;
+        static constexpr std::size_t ARENA_SIZE = ARENA_SIZE_BYTES;
+        using callable = inline_function<void(), CALLABLE_SIZE_BYTES>;
 
         static_thread(threadEntry func, native::ULONG param,
                       priority prio = priority(), const char *name = DEFAULT_NAME)
             : thread(stack_, sizeof(stack_) / sizeof(stack_[0]),
                      func, param, prio, name) {
+            setArena(this->threadArena());
         }
 
         static_thread(threadEntry func, void *param,
                       priority prio = priority(), const char *name = DEFAULT_NAME)
             : thread(stack_, sizeof(stack_) / sizeof(stack_[0]),
-                     func, param, prio, name) {
+                     func, static_cast<native::ULONG>(reinterpret_cast<std::uintptr_t>(param)), prio, name) {
+            setArena(this->threadArena());
+        }
+
+        /**
+         * @brief Creates a thread running any callable, e.g. a lambda with captures.
+         *
+         * The callable is stored in an inline buffer of `CALLABLE_SIZE_BYTES` inside the thread object,
+         * callables that don't fit are rejected at compile time. No heap memory is used.
+         *
+         * @param f The callable, invoked without arguments as the thread's entry function.
+         * @param prio The priority of the thread.
+         * @param name The name of the thread.
+         */
+        template<class F, typename = typename std::enable_if<
+            std::is_invocable_r<void, typename std::decay<F>::type &>::value>::type>
+        explicit static_thread(F &&f, priority prio = priority(), const char *name = DEFAULT_NAME)
+            : thread(stack_, sizeof(stack_) / sizeof(stack_[0]),
+                     &static_thread::invokeCallable, static_cast<native::ULONG>(reinterpret_cast<std::uintptr_t>(this)),
+                     prio, name),
+              callable_(std::forward<F>(f)) {
+            setArena(this->threadArena());
         }
 
         template<typename T>
         static_thread(typename std::enable_if<(sizeof(T) <= sizeof(std::uintptr_t)),
                           void (*)(T)>::type func, T arg,
                       priority prio = priority(), const char *name = DEFAULT_NAME)
-            : static_thread(reinterpret_cast<threadEntry>(func),
-                            reinterpret_cast<void *>(static_cast<std::uintptr_t>(arg)),
-                            prio, name) {
+            : static_thread([func, arg]() { func(arg); }, prio, name) {
         }
 
         template<typename T>
         static_thread(void (*func)(T *), T *arg,
                       priority prio = priority(), const char *name = DEFAULT_NAME)
-            : static_thread(reinterpret_cast<threadEntry>(func),
-                            reinterpret_cast<void *>(arg),
-                            prio, name) {
+            : static_thread([func, arg]() { func(arg); }, prio, name) {
         }
 
         template<typename T>
         static_thread(void (*func)(T *), T &arg,
                       priority prio = priority(), const char *name = DEFAULT_NAME)
-            : static_thread(reinterpret_cast<threadEntry>(func),
-                            reinterpret_cast<void *>(arg),
-                            prio, name) {
+            : static_thread([func, &arg]() { func(&arg); }, prio, name) {
         }
 
         template<class T>
         static_thread(T &obj, void (T::*member_func)(),
                       priority prio = priority(), const char *name = DEFAULT_NAME)
-            : static_thread(reinterpret_cast<threadEntry>(member_func),
-                            reinterpret_cast<void *>(&obj),
-                            prio, name) {
+            : static_thread([&obj, member_func]() { (obj.*member_func)(); }, prio, name) {
         }
 
-        void operator delete(void *p) {
-            ::delete p;
+        ~static_thread() {
+            // the thread must not run anymore when the callable and the stack are destroyed
+            deleteThread();
         }
 
     private:
-        unsigned char stack_[STACK_SIZE_BYTES];
+        static void invokeCallable(native::ULONG self) {
+            reinterpret_cast<static_thread *>(static_cast<std::uintptr_t>(self))->callable_();
+        }
+
+        alignas(STACK_ALIGNMENT) unsigned char stack_[STACK_SIZE_BYTES];
+        callable callable_{};
+    };
+
+
+    /**
+     * @struct thread_stack
+     * @brief Aligned stack memory for an `external_stack_thread`.
+     *
+     * The stack can be placed in a linker section independently of the thread object:
+     *
+     * @code
+     * STM32THREADXTHREAD_SECTION(".dtcmram") thread_stack<4096> controlStack;
+     * external_stack_thread controlThread(controlStack, controlLoop, 0, 2, "control");
+     * @endcode
+     *
+     * @tparam SIZE_BYTES The size of the stack in bytes.
+     * @tparam ALIGNMENT The alignment of the stack in bytes, at least 8 as required by the AAPCS.
+     */
+    template<const std::size_t SIZE_BYTES, const std::size_t ALIGNMENT = 8>
+    struct thread_stack {
+        static_assert(ALIGNMENT >= 8, "ALIGNMENT must be at least 8 bytes");
+        static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "ALIGNMENT must be a power of two");
+
+        static constexpr std::size_t SIZE = SIZE_BYTES;
+
+        alignas(ALIGNMENT) unsigned char data[SIZE_BYTES];
+    };
+
+
+    /**
+     * @class external_stack_thread
+     * @brief Thread using a stack buffer supplied by the user.
+     *
+     * The stack is either given at construction, or later with `setStack()` before calling `createThread()`.
+     */
+    class external_stack_thread : public thread {
+    public:
+        external_stack_thread(threadEntry func, native::ULONG param,
+                              priority prio = priority(), const char *name = DEFAULT_NAME)
+            : thread(func, param, prio, name) {
+        }
+
+        external_stack_thread(void *pstack, std::uint32_t stack_size,
+                              threadEntry func, native::ULONG param,
+                              priority prio = priority(), const char *name = DEFAULT_NAME)
+            : thread(pstack, stack_size, func, param, prio, name) {
+        }
+
+        template<const std::size_t SIZE_BYTES, const std::size_t ALIGNMENT>
+        external_stack_thread(thread_stack<SIZE_BYTES, ALIGNMENT> &stack,
+                              threadEntry func, native::ULONG param,
+                              priority prio = priority(), const char *name = DEFAULT_NAME)
+            : thread(stack.data, SIZE_BYTES, func, param, prio, name) {
+        }
     };
 
     /**
@@ -414,8 +1039,63 @@ namespace Stm32ThreadxThread {
          * This function returns the unique identifier of the current thread.
          *
          * @return The current thread's unique identifier
+         * @remark Thread and ISR context callable
+         */
+        inline thread::id getId() {
+            return reinterpret_cast<thread::id>(native::currentThread());
+        }
+
+        /**
+         * @brief Signals that the current thread is alive, see `thread::heartbeat()`.
+         *
+         * Does nothing if the current thread was not created by this library.
+         *
+         * @remark Thread context callable
+         */
+        inline void heartbeat() {
+            auto *current = thread::getCurrent();
+            if (current != nullptr) {
+                current->heartbeat();
+            }
+        }
+
+        /**
+         * @brief Get the arena of the current thread.
+         *
+         * @return The arena, nullptr if the current thread has none or was not created by this library.
+         *
+         * @see thread::getArena()
+         */
+        inline Stm32ThreadxThread::arena *arena() {
+            const auto *current = thread::getCurrent();
+            return (current != nullptr) ? current->getArena() : nullptr;
+        }
+
+#ifdef STM32THREADXTHREAD_TLS_SLOTS
+        /**
+         * @brief Get a thread-local storage slot of the current thread.
+         *
+         * Works for every thread, including threads not created by this library.
+         *
+         * @tparam T The type of the object in the slot.
+         * @tparam Key The key of the slot, derived from `tls_key`.
+         * @return The pointer stored in the slot, nullptr if it was never set.
+         * @note Must be called from a thread.
          */
-        thread::id getId();
+        template<class T, class Key>
+        T *tls() {
+            return static_cast<T *>(native::currentThread()->tx_thread_tls_slots[Key::slot]);
+        }
+
+        /**
+         * @brief Sets a thread-local storage slot of the current thread.
+         * @note Must be called from a thread.
+         */
+        template<class Key, class T>
+        void setTls(T *value) {
+            native::currentThread()->tx_thread_tls_slots[Key::slot] = value;
+        }
+#endif // STM32THREADXTHREAD_TLS_SLOTS
 
         /**
          * @brief Sleeps for a specified duration of time.
@@ -474,7 +1154,7 @@ namespace Stm32ThreadxThread {
          * @param abs_time The absolute time point representing the deadline to block the thread.
          *
          * @note This function internally calls `sleepFor` to block the thread for the required
-         * duration.
+         * duration. Prefer the `tick_timer::time_point` overload for periodic wakeups.
          *
          * @see sleepFor
          */
@@ -483,17 +1163,95 @@ namespace Stm32ThreadxThread {
             sleepFor(abs_time - Clock::now());
         }
 
-#if 0 && (configUSE_TASK_NOTIFICATIONS == 1)
+        /**
+         * @brief Blocks the current thread's execution until the given tick deadline.
+         *
+         * The remaining time is calculated and the thread is suspended while the thread's preemption-threshold
+         * is raised, so the thread can't be preempted between reading the clock and suspending.
+         * The difference is calculated modulo the 32-bit tick counter, so deadlines are handled correctly across a
+         * wraparound of `tx_time_get()` as long as they are less than half the counter range away.
+         *
+         * @param abs_time The absolute tick deadline.
+         * @return true if the thread slept until the deadline, false if the deadline had already been reached and
+         * the function returned immediately.
+         *
+         * @note A tick interrupt between reading the clock and suspending may still delay the wakeup by one tick.
+         * This error doesn't accumulate if the next deadline is derived from the previous one.
+         *
+         * @see periodic_timer
+         */
+        bool sleepUntil(tick_timer::time_point abs_time);
 
-        bool notify_wait_for(const tick_timer::duration& rel_time,
-                    thread::notify_flag clr_at_entry = 0, thread::notify_flag clr_at_exit = 0,
-                    thread::notify_flag *received = nullptr);
+        /**
+         * @brief Blocks the current thread's execution until the given extended tick deadline.
+         *
+         * Deadlines further away than half the 32-bit counter range are approached in steps, the final step
+         * is handled like the `tick_timer::time_point` overload.
+         *
+         * @param abs_time The absolute extended tick deadline.
+         * @return true if the thread slept until the deadline, false if the deadline had already been reached and
+         * the function returned immediately.
+         *
+         * @see tick_timer64
+         */
+        bool sleepUntil(tick_timer64::time_point abs_time);
 
-            notify_value notify_value_wait_for(const tick_timer::duration& rel_time,
-                    thread::notify_flag clr_at_entry = 0, thread::notify_flag clr_at_exit = 0,
-                    thread::notify_flag *received = nullptr);
+#ifdef STM32THREADXTHREAD_HAS_CYCLE_CLOCK
+        /**
+         * @brief Busy-waits for the given duration without giving up the CPU.
+         *
+         * Meant for short delays below one tick, e.g. a few microseconds while talking to a peripheral.
+         * Threads of higher priority and interrupts can still preempt the caller.
+         *
+         * @param rel_time The duration to wait, shorter than the `cycle_clock` counter period.
+         * @remark Thread and ISR context callable
+         * @see cycle_clock
+         */
+        inline void spinFor(cycle_clock::duration rel_time) {
+            const auto start = cycle_clock::now();
+            while (cycle_clock::now() - start < rel_time) {
+            }
+        }
+
+        /**
+         * @brief Busy-waits for at least the given duration.
+         * @see spinFor(cycle_clock::duration)
+         */
+        template<class Rep, class Period>
+        void spinFor(const std::chrono::duration<Rep, Period> &rel_time) {
+            spinFor(std::chrono::ceil<cycle_clock::duration>(rel_time));
+        }
+#endif
+
+        /**
+         * @brief Waits for notification flags sent to the current thread with `thread::notify()`.
+         *
+         * The received flags are cleared, other pending flags stay set for later calls.
+         *
+         * @param rel_time The maximum duration to wait.
+         * @param mask The flags to wait for, any of them ends the wait.
+         * @param received Receives the flags out of `mask` that were pending, may be nullptr.
+         * @return true if at least one flag was received, false if the timeout expired.
+         *
+         * @note Must be called from a thread created by this library.
+         * @remark Thread context callable
+         */
+        bool notifyWaitFor(tick_timer::duration rel_time, thread::notify_flag mask = thread::NOTIFY_ALL,
+                           thread::notify_flag *received = nullptr);
 
-#endif // (configUSE_TASK_NOTIFICATIONS == 1)
+        /**
+         * @brief Waits for notification flags sent to the current thread, for a limited time.
+         *
+         * @tparam Rep The type representing the number of ticks in the duration.
+         * @tparam Period The ratio representing the tick period.
+         *
+         * @see notifyWaitFor(tick_timer::duration, thread::notify_flag, thread::notify_flag *)
+         */
+        template<class Rep, class Period>
+        bool notifyWaitFor(const std::chrono::duration<Rep, Period> &rel_time,
+                           thread::notify_flag mask = thread::NOTIFY_ALL, thread::notify_flag *received = nullptr) {
+            return notifyWaitFor(std::chrono::duration_cast<tick_timer::duration>(rel_time), mask, received);
+        }
     }
 }
 
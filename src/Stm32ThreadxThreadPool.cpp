@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#include "Stm32ThreadxThreadPool.hpp"
+#include "Stm32ThreadxConfig.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+thread_pool::thread_pool(std::size_t slots, const char *name)
+    : free_slots(slots, slots, name), done(name),
+      free_mask((slots >= MAX_SLOTS) ? 0xFFFFFFFFUL : ((1UL << slots) - 1)) {
+}
+
+void thread_pool::createSlots() {
+    free_slots.createSemaphore();
+    done.createEventFlags();
+}
+
+std::size_t thread_pool::allocateSlot(tick_timer::duration rel_time) {
+    if (!free_slots.try_acquire_for(rel_time)) {
+        return NO_SLOT;
+    }
+
+    TX_INTERRUPT_SAVE_AREA
+    TX_DISABLE
+    // the semaphore guarantees that at least one bit is set
+    const auto slot = static_cast<std::size_t>(__builtin_ctz(free_mask));
+    const std::uint32_t bit = 1UL << slot;
+    free_mask &= ~bit;
+    job_mask |= bit;
+    handle_mask |= bit;
+    TX_RESTORE
+
+    done.clear(bit);
+    return slot;
+}
+
+void thread_pool::finishJob(std::size_t slot) {
+    done.set(1UL << slot);
+    releaseOwnership(job_mask, slot);
+}
+
+bool thread_pool::waitDone(std::size_t slot, tick_timer::duration rel_time) {
+    return done.waitAllFor(1UL << slot, rel_time, false) != 0;
+}
+
+bool thread_pool::isDone(std::size_t slot) const {
+    return (done.get() & (1UL << slot)) != 0;
+}
+
+void thread_pool::releaseHandle(std::size_t slot) {
+    releaseOwnership(handle_mask, slot);
+}
+
+void thread_pool::releaseOwnership(std::uint32_t &owners, std::size_t slot) {
+    const std::uint32_t bit = 1UL << slot;
+    bool released;
+
+    TX_INTERRUPT_SAVE_AREA
+    TX_DISABLE
+    owners &= ~bit;
+    released = ((job_mask | handle_mask) & bit) == 0;
+    if (released) {
+        free_mask |= bit;
+    }
+    TX_RESTORE
+
+    if (released) {
+        free_slots.release();
+    }
+}
@@ -0,0 +1,306 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXTHREADPOOL_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXTHREADPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "Stm32ThreadxThread.hpp"
+#include "Stm32ThreadxQueue.hpp"
+#include "Stm32ThreadxSemaphore.hpp"
+#include "Stm32ThreadxEventFlags.hpp"
+#include "Stm32ThreadxInlineFunction.hpp"
+
+namespace Stm32ThreadxThread {
+    /**
+     * @class thread_pool
+     * @brief Bookkeeping of the job slots of a `static_thread_pool`.
+     *
+     * A slot is owned by the pending job and by the `job_handle` returned on submission,
+     * it is released when both are done with it.
+     *
+     * @see static_thread_pool
+     */
+    class thread_pool {
+    public:
+        static constexpr std::size_t MAX_SLOTS = 32;
+
+        /**
+         * @class job_handle
+         * @brief Future-like handle to wait for the completion of a submitted job.
+         *
+         * An empty handle is returned if the job could not be submitted. Destroying the handle detaches it from
+         * the job, the job still runs.
+         */
+        class job_handle {
+        public:
+            job_handle() = default;
+
+            job_handle(job_handle &&other) noexcept
+                : pool(other.pool), slot(other.slot) {
+                other.pool = nullptr;
+            }
+
+            job_handle &operator=(job_handle &&other) noexcept {
+                if (this != &other) {
+                    release();
+                    pool = other.pool;
+                    slot = other.slot;
+                    other.pool = nullptr;
+                }
+                return *this;
+            }
+
+            job_handle(const job_handle &) = delete;
+
+            job_handle &operator=(const job_handle &) = delete;
+
+            ~job_handle() {
+                release();
+            }
+
+            /**
+             * @brief Checks if the handle refers to a submitted job.
+             */
+            explicit operator bool() const {
+                return pool != nullptr;
+            }
+
+            /**
+             * @brief Waits until the job has completed.
+             * @param rel_time The maximum duration to wait.
+             * @return true if the job has completed, false if the timeout expired or the handle is empty.
+             * @remark Thread context callable, ISR context callable with `rel_time` zero
+             */
+            bool waitFor(tick_timer::duration rel_time) {
+                return (pool != nullptr) && pool->waitDone(slot, rel_time);
+            }
+
+            /**
+             * @brief Waits without timeout until the job has completed.
+             */
+            void wait() {
+                waitFor(infinity);
+            }
+
+            /**
+             * @brief Checks without blocking if the job has completed.
+             * @remark Thread and ISR context callable
+             */
+            [[nodiscard]] bool isDone() const {
+                return (pool != nullptr) && pool->isDone(slot);
+            }
+
+            /**
+             * @brief Detaches the handle from the job.
+             */
+            void release() {
+                if (pool != nullptr) {
+                    pool->releaseHandle(slot);
+                    pool = nullptr;
+                }
+            }
+
+        private:
+            friend class thread_pool;
+
+            job_handle(thread_pool *pool, std::size_t slot)
+                : pool(pool), slot(slot) {
+            }
+
+            thread_pool *pool{};
+            std::size_t slot{};
+        };
+
+    protected:
+        static constexpr const char *DEFAULT_NAME = "N/A";
+        static constexpr std::size_t NO_SLOT = MAX_SLOTS;
+
+        thread_pool(std::size_t slots, const char *name);
+
+        void createSlots();
+
+        /**
+         * @brief Reserves a free slot for a job and a handle.
+         * @return The index of the slot, `NO_SLOT` if no slot became free within `rel_time`.
+         */
+        std::size_t allocateSlot(tick_timer::duration rel_time);
+
+        /**
+         * @brief Marks the job in the slot as completed and releases the job's ownership of the slot.
+         */
+        void finishJob(std::size_t slot);
+
+        static job_handle makeHandle(thread_pool *pool, std::size_t slot) {
+            return job_handle(pool, slot);
+        }
+
+    private:
+        thread_pool(const thread_pool &) = delete;
+
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        bool waitDone(std::size_t slot, tick_timer::duration rel_time);
+
+        bool isDone(std::size_t slot) const;
+
+        void releaseHandle(std::size_t slot);
+
+        void releaseOwnership(std::uint32_t &owners, std::size_t slot);
+
+        semaphore free_slots;
+        event_flags done;
+        std::uint32_t free_mask{};
+        std::uint32_t job_mask{};
+        std::uint32_t handle_mask{};
+    };
+
+
+    /**
+     * @class static_thread_pool
+     * @brief Pool of worker threads draining a shared bounded job queue.
+     *
+     * Jobs are callables stored inline in one of `QUEUE_DEPTH` job slots, so neither submitting nor running a
+     * job allocates memory. Jobs can be submitted from thread and ISR context.
+     *
+     * @code
+     * static_thread_pool<2, 1024, 8> pool(10, "worker");
+     * pool.createThreadPool();
+     * auto handle = pool.submit([&] { flash.write(block); });
+     * handle.waitFor(std::chrono::milliseconds(100));
+     * @endcode
+     *
+     * @tparam N_THREADS The number of worker threads.
+     * @tparam STACK_SIZE_BYTES The stack size of each worker thread in bytes.
+     * @tparam QUEUE_DEPTH The maximum number of submitted, not yet completed jobs, at most 32.
+     * @tparam JOB_SIZE_BYTES The size of the inline buffer of each job in bytes.
+     */
+    template<std::size_t N_THREADS, std::size_t STACK_SIZE_BYTES, std::size_t QUEUE_DEPTH,
+        std::size_t JOB_SIZE_BYTES = 4 * sizeof(void *)>
+    class static_thread_pool : public thread_pool {
+        static_assert(N_THREADS > 0, "N_THREADS must be greater than zero");
+        static_assert(QUEUE_DEPTH > 0 && QUEUE_DEPTH <= MAX_SLOTS, "QUEUE_DEPTH must be within 1..32");
+
+        using worker_type = static_thread<STACK_SIZE_BYTES>;
+
+    public:
+        using job = inline_function<void(), JOB_SIZE_BYTES>;
+        using priority = thread::priority;
+
+        /**
+         * @brief Constructs the pool, without creating the kernel objects.
+         *
+         * @param prio The priority of all worker threads.
+         * @param name The name of the worker threads and the kernel objects.
+         *
+         * @see createThreadPool()
+         */
+        explicit static_thread_pool(priority prio = priority(), const char *name = DEFAULT_NAME)
+            : static_thread_pool(std::make_index_sequence<N_THREADS>(), prio, name) {
+        }
+
+        /**
+         * @brief Creates the kernel objects and starts the worker threads.
+         */
+        void createThreadPool() {
+            createSlots();
+            jobs.createQueue();
+            for (auto &worker: workers) {
+                worker.createThread();
+                worker.resume();
+            }
+        }
+
+        /**
+         * @brief Submits a job without blocking.
+         *
+         * @param f The callable to run on a worker thread.
+         * @return Handle to wait for the completion of the job, empty if all job slots are in use.
+         * @remark Thread and ISR context callable
+         */
+        template<class F>
+        job_handle submit(F &&f) {
+            return submitFor(std::forward<F>(f), tick_timer::duration::zero());
+        }
+
+        /**
+         * @brief Submits a job, blocks until a job slot is free or the timeout expires.
+         *
+         * @param f The callable to run on a worker thread.
+         * @param rel_time The maximum duration to wait for a free job slot.
+         * @return Handle to wait for the completion of the job, empty if no job slot became free.
+         * @remark Thread context callable, ISR context callable with `rel_time` zero
+         */
+        template<class F>
+        job_handle submitFor(F &&f, tick_timer::duration rel_time) {
+            const std::size_t slot = allocateSlot(rel_time);
+            if (slot == NO_SLOT) {
+                return job_handle();
+            }
+            slots[slot].emplace(std::forward<F>(f));
+            // a slot is free only if its index is not in the queue, so the queue can't be full
+            jobs.trySend(static_cast<native::ULONG>(slot));
+            return makeHandle(this, slot);
+        }
+
+        /**
+         * @brief Changes the priority of all worker threads.
+         */
+        void setPriority(priority prio) {
+            for (auto &worker: workers) {
+                worker.setPriority(prio);
+            }
+        }
+
+        /**
+         * @brief Get a worker thread, e.g. to tune its priority or to read its statistics.
+         */
+        thread &getWorker(std::size_t index) {
+            return workers[index];
+        }
+
+        static constexpr std::size_t size() {
+            return N_THREADS;
+        }
+
+    private:
+        template<std::size_t... I>
+        static_thread_pool(std::index_sequence<I...>, priority prio, const char *name)
+            : thread_pool(QUEUE_DEPTH, name), jobs(name), workers{makeWorker<I>(prio, name)...} {
+        }
+
+        template<std::size_t>
+        worker_type makeWorker(priority prio, const char *name) {
+            return worker_type(&static_thread_pool::workerEntry,
+                               static_cast<native::ULONG>(reinterpret_cast<std::uintptr_t>(this)), prio, name);
+        }
+
+        static void workerEntry(native::ULONG self) {
+            auto *pool = reinterpret_cast<static_thread_pool *>(static_cast<std::uintptr_t>(self));
+            for (;;) {
+                native::ULONG slot;
+                pool->jobs.receive(slot);
+                pool->slots[slot]();
+                pool->slots[slot].reset();
+                pool->finishJob(slot);
+            }
+        }
+
+        job slots[QUEUE_DEPTH]{};
+        static_queue<native::ULONG, QUEUE_DEPTH> jobs;
+        worker_type workers[N_THREADS];
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXTHREADPOOL_HPP
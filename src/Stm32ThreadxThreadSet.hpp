@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXTHREADSET_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXTHREADSET_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include "Stm32ThreadxThread.hpp"
+
+namespace Stm32ThreadxThread {
+    /**
+     * @struct thread_def
+     * @brief Compile time declaration of a static thread, used as entry of a `thread_set`.
+     *
+     * The priority and the stack size are checked at compile time.
+     *
+     * @tparam NAME The name of the thread, a `constexpr char[]` with static storage duration.
+     * @tparam STACK_SIZE_BYTES The stack size of the thread in bytes, at least `MIN_STACK_SIZE`.
+     * @tparam PRIO The priority of the thread, lower than `TX_MAX_PRIORITIES`.
+     * @tparam ENTRY The entry function of the thread.
+     * @tparam PARAM The parameter passed to the entry function.
+     */
+    template<const char *NAME, std::size_t STACK_SIZE_BYTES, thread::priority::value_type PRIO,
+        thread::threadEntry ENTRY, native::ULONG PARAM = 0>
+    struct thread_def {
+        static_assert(PRIO < thread::priority::max(), "PRIO must be lower than TX_MAX_PRIORITIES");
+        static_assert(STACK_SIZE_BYTES >= native::MIN_STACK_SIZE, "STACK_SIZE_BYTES must be at least MIN_STACK_SIZE");
+        static_assert(ENTRY != nullptr, "ENTRY must not be nullptr");
+
+        using thread_type = static_thread<STACK_SIZE_BYTES>;
+
+        static constexpr const char *name = NAME;
+        static constexpr std::size_t stack_size = STACK_SIZE_BYTES;
+        static constexpr thread::priority::value_type prio = PRIO;
+        static constexpr thread::threadEntry entry = ENTRY;
+        static constexpr native::ULONG param = PARAM;
+    };
+
+    namespace detail {
+        template<std::size_t I, class Def>
+        struct thread_slot {
+            typename Def::thread_type thread{Def::entry, Def::param, Def::prio, Def::name};
+        };
+
+        template<class Seq, class... Defs>
+        struct thread_slots;
+
+        template<std::size_t... Is, class... Defs>
+        struct thread_slots<std::index_sequence<Is...>, Defs...> : thread_slot<Is, Defs>... {
+        };
+    }
+
+    /**
+     * @class thread_set
+     * @brief Table of all static threads of an application, created and started in one pass.
+     *
+     * The threads are members of the set and are created and resumed in the order of their declaration.
+     *
+     * @code
+     * constexpr char CONTROL_NAME[] = "control";
+     * constexpr char COMM_NAME[] = "comm";
+     *
+     * thread_set<
+     *     thread_def<CONTROL_NAME, 2048, 2, &controlLoop>,
+     *     thread_def<COMM_NAME, 1024, 5, &commLoop>
+     * > threads;
+     *
+     * void tx_application_define(void *) {
+     *     threads.start();
+     * }
+     * @endcode
+     *
+     * @tparam Defs The `thread_def` declarations of the threads.
+     */
+    template<class... Defs>
+    class thread_set : private detail::thread_slots<std::index_sequence_for<Defs...>, Defs...> {
+        static_assert(sizeof...(Defs) > 0, "thread_set needs at least one thread");
+
+        template<std::size_t I>
+        using def_at = std::tuple_element_t<I, std::tuple<Defs...> >;
+
+    public:
+        thread_set() = default;
+
+        /**
+         * @brief Get the number of threads in the set.
+         */
+        static constexpr std::size_t size() {
+            return sizeof...(Defs);
+        }
+
+        /**
+         * @brief Get the thread declared at index `I`.
+         */
+        template<std::size_t I>
+        typename def_at<I>::thread_type &get() {
+            return static_cast<detail::thread_slot<I, def_at<I> > &>(*this).thread;
+        }
+
+        /**
+         * @brief Creates all threads in declaration order, without starting them.
+         */
+        void createAll() {
+            forEachIndex([this](auto i) { get<decltype(i)::value>().createThread(); });
+        }
+
+        /**
+         * @brief Resumes all threads in declaration order.
+         */
+        void resumeAll() {
+            forEachIndex([this](auto i) { get<decltype(i)::value>().resume(); });
+        }
+
+        /**
+         * @brief Creates all threads, then resumes them, both in declaration order.
+         */
+        void start() {
+            createAll();
+            resumeAll();
+        }
+
+    private:
+        thread_set(const thread_set &) = delete;
+
+        thread_set &operator=(const thread_set &) = delete;
+
+        template<class F, std::size_t... Is>
+        static void forEachIndex(F f, std::index_sequence<Is...>) {
+            (f(std::integral_constant<std::size_t, Is>()), ...);
+        }
+
+        template<class F>
+        static void forEachIndex(F f) {
+            forEachIndex(f, std::index_sequence_for<Defs...>());
+        }
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXTHREADSET_HPP
@@ -20,6 +20,7 @@
  */
 
 #include "Stm32ThreadxTickTimer.hpp"
+#include <limits>
 
 using namespace Stm32ThreadxThread;
 using namespace Stm32ThreadxThread::native;
@@ -28,3 +29,27 @@ tick_timer::time_point tick_timer::now() {
     rep ticks = tx_time_get();
     return time_point(duration(ticks));
 }
+
+namespace {
+    // low word of the last read and the number of wraparounds seen so far, only accessed with interrupts disabled
+    ULONG tick_last_low = 0;
+    ULONG tick_wraps = 0;
+}
+
+tick_timer64::time_point tick_timer64::now() {
+    if constexpr (sizeof(ULONG) >= sizeof(rep)) {
+        return time_point(duration(static_cast<rep>(tx_time_get())));
+    } else {
+        TX_INTERRUPT_SAVE_AREA
+        TX_DISABLE
+        const ULONG low = tx_time_get();
+        if (low < tick_last_low) {
+            ++tick_wraps;
+        }
+        tick_last_low = low;
+        const auto ticks = static_cast<rep>(
+            (static_cast<std::uint64_t>(tick_wraps) << std::numeric_limits<ULONG>::digits) | low);
+        TX_RESTORE
+        return time_point(duration(ticks));
+    }
+}
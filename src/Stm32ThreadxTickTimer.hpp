@@ -23,10 +23,35 @@
 #define LIBSMART_STM32THREADXTHREAD_STM32THREADXTICKTIMER_HPP
 
 #include <chrono>
+#include <cstdint>
 #include "tx_api.h"
 //#include "Stm32ThreadxThread.hpp"
 
 
+/**
+ * @brief Frequency of the counter behind `cycle_clock` in Hz.
+ *
+ * Usually the core clock, or the count frequency of the timer configured with
+ * `STM32THREADXTHREAD_CYCLE_COUNTER()`. `cycle_clock` is only available on target if this is defined.
+ */
+#if !defined(STM32THREADXTHREAD_CYCLE_CLOCK_HZ) && !defined(__arm__)
+#define STM32THREADXTHREAD_CYCLE_CLOCK_HZ 1000000000
+#endif
+
+/**
+ * @brief Expression reading a free-running 32-bit counter, e.g. `(TIM2->CNT)`.
+ *
+ * Replaces the DWT cycle counter as source of `cycle_clock`, required on cores without one
+ * like the Cortex-M0/M0+.
+ */
+#if defined(STM32THREADXTHREAD_CYCLE_CLOCK_HZ)
+#if defined(STM32THREADXTHREAD_CYCLE_COUNTER) || !defined(__arm__) || \
+    defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+#define STM32THREADXTHREAD_HAS_CYCLE_CLOCK 1
+#endif
+#endif
+
 namespace Stm32ThreadxThread {
     namespace native {
         // these macros use native type casts, so need some redirection
@@ -54,6 +79,117 @@ namespace Stm32ThreadxThread {
         static time_point now();
     };
 
+    /**
+     * @brief A clock extending the ThreadX tick count to 64 bits.
+     *
+     * The 32-bit `tx_time_get()` count wraps after about 49 days at 1 kHz. `tick_timer64` counts the
+     * wraparounds on every read, so its time points never wrap in practice and durations between them can
+     * be calculated with plain arithmetic. The representation is signed, so differences of time points may
+     * be negative.
+     *
+     * @note A wraparound is only detected if `now()` is called at least once per period of the 32-bit
+     * counter, e.g. from a periodic thread or application timer. Changing the tick count with
+     * `tx_time_set()` breaks the extension.
+     */
+    class tick_timer64 {
+    public:
+        using rep = std::int64_t;
+        using period = tick_timer::period;
+        using duration = std::chrono::duration<rep, period>;
+        using time_point = std::chrono::time_point<tick_timer64>;
+        static constexpr bool is_steady = true;
+
+        /**
+         * @brief Gets the current OS tick count, extended to 64 bits.
+         * @return The current extended tick count as time_point
+         * @remark Thread and ISR context callable
+         */
+        static time_point now();
+    };
+
+#ifdef STM32THREADXTHREAD_HAS_CYCLE_CLOCK
+    /**
+     * @brief A high-resolution clock based on the DWT cycle counter.
+     *
+     * Resolves to single core clock cycles for measuring ISR latencies or control loop lengths. The source is
+     * the `STM32THREADXTHREAD_CYCLE_COUNTER()` expression if defined, the DWT CYCCNT register on ARMv7-M and
+     * ARMv8-M Mainline cores, or `std::chrono::steady_clock` on the host.
+     *
+     * @note The 32-bit counter wraps after 2^32 cycles, about 25 s at 168 MHz. Durations between two time
+     * points are correct as long as they are shorter than that.
+     */
+    class cycle_clock {
+    public:
+        using rep = std::uint32_t;
+        using period = std::ratio<1, STM32THREADXTHREAD_CYCLE_CLOCK_HZ>;
+        using duration = std::chrono::duration<rep, period>;
+        using time_point = std::chrono::time_point<cycle_clock>;
+        static constexpr bool is_steady = true;
+
+        /**
+         * @brief Enables the DWT cycle counter.
+         *
+         * Must be called once before using the clock, unless a debugger or `STM32THREADXTHREAD_CYCLE_COUNTER()`
+         * is used.
+         */
+        static void init() {
+#if !defined(STM32THREADXTHREAD_CYCLE_COUNTER) && defined(__arm__)
+            reg(DEMCR) |= DEMCR_TRCENA;
+            reg(DWT_LAR) = DWT_LAR_UNLOCK;
+            reg(DWT_CYCCNT) = 0;
+            reg(DWT_CTRL) |= DWT_CTRL_CYCCNTENA;
+#endif
+        }
+
+        /**
+         * @brief Reads the current counter value.
+         * @return The current counter value as time_point
+         * @remark Thread and ISR context callable
+         */
+        static time_point now() {
+#if defined(STM32THREADXTHREAD_CYCLE_COUNTER)
+            return time_point(duration(static_cast<rep>(STM32THREADXTHREAD_CYCLE_COUNTER())));
+#elif defined(__arm__)
+            return time_point(duration(reg(DWT_CYCCNT)));
+#else
+            const auto host = std::chrono::steady_clock::now().time_since_epoch();
+            return time_point(duration(static_cast<rep>(std::chrono::duration_cast<
+                std::chrono::duration<std::uint64_t, period> >(host).count())));
+#endif
+        }
+
+        /**
+         * @brief Converts a cycle duration to a tick duration, rounded towards zero.
+         */
+        static constexpr tick_timer::duration toTickTimer(const duration &d) {
+            return std::chrono::duration_cast<tick_timer::duration>(d);
+        }
+
+        /**
+         * @brief Converts a tick duration to a cycle duration.
+         * @note The result wraps for durations longer than the counter period.
+         */
+        static constexpr duration fromTickTimer(const tick_timer::duration &d) {
+            return std::chrono::duration_cast<duration>(d);
+        }
+
+    private:
+#if !defined(STM32THREADXTHREAD_CYCLE_COUNTER) && defined(__arm__)
+        static constexpr std::uintptr_t DWT_CTRL = 0xE0001000UL;
+        static constexpr std::uintptr_t DWT_CYCCNT = 0xE0001004UL;
+        static constexpr std::uintptr_t DWT_LAR = 0xE0001FB0UL;
+        static constexpr std::uintptr_t DEMCR = 0xE000EDFCUL;
+        static constexpr std::uint32_t DEMCR_TRCENA = 1UL << 24;
+        static constexpr std::uint32_t DWT_CTRL_CYCCNTENA = 1UL << 0;
+        static constexpr std::uint32_t DWT_LAR_UNLOCK = 0xC5ACCE55UL;
+
+        static volatile std::uint32_t &reg(std::uintptr_t address) {
+            return *reinterpret_cast<volatile std::uint32_t *>(address);
+        }
+#endif
+    };
+#endif
+
     /**
      * @brief Converts duration to the underlying tick count.
      *
@@ -96,6 +232,18 @@ namespace Stm32ThreadxThread {
         return toTicks(time.time_since_epoch());
     }
 
+    /**
+     * @brief Converts an extended time point to the underlying tick count.
+     *
+     * @param time The time point from the start of the `tick_timer64`.
+     * @return The 64-bit tick count equivalent to the given time point.
+     *
+     * @see tick_timer64::time_point
+     */
+    constexpr tick_timer64::rep toTicks(const tick_timer64::time_point &time) {
+        return time.time_since_epoch().count();
+    }
+
     /**
      * @brief  Dedicated @ref tick_timer::duration expression that ensures infinite wait time on an operation.
      */
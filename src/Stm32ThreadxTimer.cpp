@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include "Stm32ThreadxTimer.hpp"
+#include "Stm32ThreadxConfig.hpp"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+void timer::createTimer() {
+    // https://github.com/eclipse-threadx/rtos-docs/blob/main/rtos-docs/threadx/chapter4.md#tx_timer_create
+    STM32THREADXTHREAD_ASSERT(toTicks(initial) > 0);
+    STM32THREADXTHREAD_ASSERT(m == mode::oneShot || toTicks(period) > 0);
+    auto result = tx_timer_create(
+        this, // TX_TIMER *timer_ptr
+        const_cast<char *>(name), // CHAR *name_ptr
+        &timer::expirationEntry, // VOID (*expiration_function)(ULONG input)
+        static_cast<ULONG>(reinterpret_cast<std::uintptr_t>(this)), // ULONG expiration_input
+        toTicks(initial), // ULONG initial_ticks
+        rescheduleTicks(), // ULONG reschedule_ticks
+        TX_NO_ACTIVATE); // UINT auto_activate
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+timer::~timer() {
+    if (!isCreated()) {
+        return;
+    }
+    auto result = tx_timer_delete(this);
+    assert(result == TX_SUCCESS);
+    (void) result;
+}
+
+void timer::start() {
+    if (isActive()) {
+        return;
+    }
+    // an expired one-shot timer has to be changed before it can be activated again
+    auto result = tx_timer_change(this, toTicks(initial), rescheduleTicks());
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    result = tx_timer_activate(this);
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+void timer::stop() {
+    auto result = tx_timer_deactivate(this);
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+}
+
+void timer::reschedule(tick_timer::duration initial, tick_timer::duration period) {
+    STM32THREADXTHREAD_ASSERT(toTicks(initial) > 0);
+    // a zero period would silently make a periodic timer one-shot
+    STM32THREADXTHREAD_ASSERT(m == mode::oneShot || toTicks(period) > 0);
+    this->initial = initial;
+    this->period = period;
+    stop();
+    start();
+}
+
+bool timer::isActive() const {
+    UINT active = TX_FALSE;
+    auto result = tx_timer_info_get(const_cast<timer *>(this), nullptr, &active, nullptr, nullptr, nullptr);
+    return (result == TX_SUCCESS) && (active == TX_TRUE);
+}
+
+bool timer::isCreated() const {
+    return tx_timer_id == TX_TIMER_ID;
+}
+
+void timer::expirationEntry(ULONG self) {
+    auto *t = reinterpret_cast<timer *>(static_cast<std::uintptr_t>(self));
+    t->cb();
+}
@@ -0,0 +1,179 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXTIMER_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXTIMER_HPP
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include "tx_api.h"
+#include "Stm32ThreadxTickTimer.hpp"
+#include "Stm32ThreadxInlineFunction.hpp"
+
+namespace Stm32ThreadxThread {
+    namespace native {
+        using ULONG = ULONG;
+        using TX_TIMER = TX_TIMER;
+    }
+
+    /**
+     * @class timer
+     * @brief Wraps a ThreadX application timer with a callable callback.
+     *
+     * The callback runs on the ThreadX system timer thread, or in the timer ISR if `TX_TIMER_PROCESS_IN_ISR`
+     * is defined. It must not block and should be short, because all timers share that context. Polling work
+     * that would otherwise need a thread sleeping in a loop can be moved into a periodic timer, saving its
+     * stack and control block.
+     *
+     * @code
+     * timer blink([]() { HAL_GPIO_TogglePin(LED_GPIO_Port, LED_Pin); }, std::chrono::milliseconds(500));
+     * blink.createTimer();
+     * blink.start();
+     * @endcode
+     *
+     * @note The timer must be created by calling `createTimer()` before it is used.
+     */
+    class timer : private native::TX_TIMER {
+    public:
+        static constexpr std::size_t CALLBACK_SIZE_BYTES = 4 * sizeof(void *);
+        using callback = inline_function<void(), CALLBACK_SIZE_BYTES>;
+
+        /**
+         * @brief Expiration mode of a timer.
+         */
+        enum class mode {
+            oneShot, ///< expires once after the initial time
+            periodic ///< expires after the initial time and then once every period
+        };
+
+        /**
+         * @brief Constructs a timer object, without creating the kernel object.
+         *
+         * @param f The callback, called on every expiration.
+         * @param period The time until the first expiration and, in periodic mode, between expirations.
+         * @param m The expiration mode.
+         * @param name The name of the timer.
+         *
+         * @see createTimer()
+         */
+        template<class F>
+        timer(F &&f, tick_timer::duration period, mode m = mode::periodic, const char *name = DEFAULT_NAME)
+            : timer(std::forward<F>(f), period, period, m, name) {
+        }
+
+        /**
+         * @brief Constructs a timer object with a different first expiration, without creating the kernel object.
+         *
+         * @param f The callback, called on every expiration.
+         * @param initial The time until the first expiration.
+         * @param period The time between expirations in periodic mode.
+         * @param m The expiration mode.
+         * @param name The name of the timer.
+         *
+         * @see createTimer()
+         */
+        template<class F>
+        timer(F &&f, tick_timer::duration initial, tick_timer::duration period, mode m = mode::periodic,
+              const char *name = DEFAULT_NAME)
+            : TX_TIMER(), cb(std::forward<F>(f)), initial(initial), period(period), m(m), name(name) {
+        }
+
+        ~timer();
+
+        /**
+         * @brief Create the timer by calling `tx_timer_create()`, without activating it.
+         */
+        void createTimer();
+
+        /**
+         * @brief Activates the timer, the first expiration is after the initial time.
+         *
+         * Does nothing if the timer is already active.
+         * @remark Thread and ISR context callable
+         */
+        void start();
+
+        /**
+         * @brief Deactivates the timer.
+         * @remark Thread and ISR context callable
+         */
+        void stop();
+
+        /**
+         * @brief Restarts the timer with new expiration times.
+         *
+         * @param initial The time until the next expiration.
+         * @param period The time between expirations in periodic mode.
+         * @remark Thread and ISR context callable
+         */
+        void reschedule(tick_timer::duration initial, tick_timer::duration period);
+
+        /**
+         * @brief Restarts the timer, expiring after `rel_time` and, in periodic mode, every `rel_time` thereafter.
+         * @remark Thread and ISR context callable
+         */
+        void reschedule(tick_timer::duration rel_time) {
+            reschedule(rel_time, rel_time);
+        }
+
+        template<class Rep, class Period>
+        void reschedule(const std::chrono::duration<Rep, Period> &rel_time) {
+            reschedule(std::chrono::duration_cast<tick_timer::duration>(rel_time));
+        }
+
+        /**
+         * @brief Checks if the timer is active.
+         * @remark Thread and ISR context callable
+         */
+        [[nodiscard]] bool isActive() const;
+
+        /**
+         * @brief Get the expiration mode of the timer.
+         */
+        [[nodiscard]] mode getMode() const {
+            return m;
+        }
+
+        /**
+         * @brief Get the time between expirations.
+         */
+        [[nodiscard]] tick_timer::duration getPeriod() const {
+            return period;
+        }
+
+    protected:
+        static constexpr const char *DEFAULT_NAME = "N/A";
+
+    private:
+        timer(const timer &) = delete;
+
+        timer &operator=(const timer &) = delete;
+
+        [[nodiscard]] bool isCreated() const;
+
+        [[nodiscard]] native::ULONG rescheduleTicks() const {
+            return (m == mode::periodic) ? toTicks(period) : 0;
+        }
+
+        static void expirationEntry(native::ULONG self);
+
+        callback cb;
+        tick_timer::duration initial{};
+        tick_timer::duration period{};
+        mode m{mode::periodic};
+        const char *name{};
+    };
+}
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXTIMER_HPP
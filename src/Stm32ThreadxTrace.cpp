@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+#include "Stm32ThreadxTrace.hpp"
+
+#ifdef TX_ENABLE_EVENT_TRACE
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include "Stm32ThreadxConfig.hpp"
+#include "tx_trace.h"
+
+using namespace Stm32ThreadxThread;
+using namespace Stm32ThreadxThread::native;
+
+namespace {
+    alignas(ULONG) UCHAR trace_buffer[STM32THREADXTHREAD_TRACE_BUFFER_SIZE];
+
+    // next entry to be converted, and its position in the trace counted from enabling
+    TX_TRACE_BUFFER_ENTRY *read_ptr = nullptr;
+    std::uint64_t read_index = 0;
+    // wraparounds of the kernel's write pointer, counted by the buffer full notification
+    volatile ULONG wraps = 0;
+    std::uint32_t dropped = 0;
+
+    constexpr std::size_t CHUNK_RECORDS = 8;
+
+#ifdef __arm__
+    // ITM registers, see the ARMv7-M Architecture Reference Manual
+    constexpr std::uintptr_t ITM_STIM0 = 0xE0000000UL;
+    constexpr std::uintptr_t ITM_TER = 0xE0000E00UL;
+    constexpr std::uintptr_t ITM_TCR = 0xE0000E80UL;
+    constexpr std::uint32_t ITM_TCR_ITMENA = 1UL << 0;
+
+    volatile std::uint32_t &reg(std::uintptr_t address) {
+        return *reinterpret_cast<volatile std::uint32_t *>(address);
+    }
+#endif
+
+    void bufferFullCallback(VOID *) {
+        // called by the kernel with interrupts disabled, when the write pointer wraps to the start
+        wraps = wraps + 1;
+    }
+
+    trace::record toRecord(const TX_TRACE_BUFFER_ENTRY &entry, std::uint64_t index) {
+        trace::record r{};
+        r.event_id = static_cast<std::uint16_t>(entry.tx_trace_buffer_entry_event_id);
+        r.priority = static_cast<std::uint8_t>(std::min<ULONG>(entry.tx_trace_buffer_entry_thread_priority, 255));
+        r.sequence = static_cast<std::uint8_t>(index);
+        r.thread = static_cast<std::uint32_t>(entry.tx_trace_buffer_entry_thread_pointer);
+        r.time_stamp = static_cast<std::uint32_t>(entry.tx_trace_buffer_entry_time_stamp);
+        r.info = static_cast<std::uint32_t>(entry.tx_trace_buffer_entry_information_field_1);
+        return r;
+    }
+}
+
+void trace::enable() {
+    // https://github.com/eclipse-threadx/rtos-docs/blob/main/rtos-docs/threadx/chapter5.md#tx_trace_enable
+    auto result = tx_trace_enable(trace_buffer, sizeof(trace_buffer), STM32THREADXTHREAD_TRACE_REGISTRY_ENTRIES);
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    wraps = 0;
+    result = tx_trace_buffer_full_notify(&bufferFullCallback);
+    STM32THREADXTHREAD_ASSERT(result == TX_SUCCESS);
+    (void) result;
+    read_ptr = _tx_trace_buffer_start_ptr;
+    read_index = 0;
+    dropped = 0;
+}
+
+void trace::disable() {
+    tx_trace_disable();
+}
+
+void trace::filter(ULONG event_bits) {
+    tx_trace_event_filter(event_bits);
+}
+
+void trace::drainNames(sink s) {
+    for (auto *entry = _tx_trace_registry_start_ptr; entry != nullptr && entry < _tx_trace_registry_end_ptr; ++entry) {
+        if (entry->tx_trace_object_entry_available != TX_FALSE) {
+            continue;
+        }
+        const auto *name = reinterpret_cast<const char *>(entry->tx_trace_object_entry_name);
+        name_record n{};
+        n.event_id = NAME_RECORD_ID;
+        n.type = entry->tx_trace_object_entry_type;
+        n.length = static_cast<std::uint8_t>(std::find(name, name + TX_TRACE_OBJECT_REGISTRY_NAME, '\0') - name);
+        n.object = static_cast<std::uint32_t>(entry->tx_trace_object_entry_thread_pointer);
+        s(&n, sizeof(n));
+        s(name, n.length);
+    }
+}
+
+std::size_t trace::read(record *buffer, std::size_t max_records) {
+    if (read_ptr == nullptr) {
+        return 0;
+    }
+    TX_INTERRUPT_SAVE_AREA
+    TX_DISABLE
+    auto *const current = _tx_trace_buffer_current_ptr;
+    const ULONG current_wraps = wraps;
+    TX_RESTORE
+
+    // position of the next entry the kernel writes, counted from enabling
+    const auto capacity = static_cast<std::uint64_t>(_tx_trace_buffer_end_ptr - _tx_trace_buffer_start_ptr);
+    const std::uint64_t written = current_wraps * capacity +
+                                  static_cast<std::uint64_t>(current - _tx_trace_buffer_start_ptr);
+    if (written - read_index > capacity) {
+        // the kernel has lapped the reader, continue with the oldest entry not yet overwritten
+        dropped += static_cast<std::uint32_t>(written - read_index - capacity);
+        read_index = written - capacity;
+        read_ptr = current;
+    }
+
+    std::size_t n = 0;
+    while (read_index != written && n < max_records) {
+        // entries not yet written since enabling have no event
+        if (read_ptr->tx_trace_buffer_entry_event_id != 0) {
+            buffer[n++] = toRecord(*read_ptr, read_index);
+        }
+        ++read_index;
+        if (++read_ptr >= _tx_trace_buffer_end_ptr) {
+            read_ptr = _tx_trace_buffer_start_ptr;
+        }
+    }
+    return n;
+}
+
+std::uint32_t trace::getDropped() {
+    return dropped;
+}
+
+std::size_t trace::drain(sink s) {
+    record chunk[CHUNK_RECORDS];
+    std::size_t total = 0;
+    std::size_t n;
+    while ((n = read(chunk, CHUNK_RECORDS)) > 0) {
+        s(chunk, n * sizeof(record));
+        total += n;
+    }
+    return total;
+}
+
+void trace::itmSink(const void *data, std::size_t size) {
+#ifdef __arm__
+    if ((reg(ITM_TCR) & ITM_TCR_ITMENA) == 0 || (reg(ITM_TER) & 1UL) == 0) {
+        return;
+    }
+    const auto *bytes = static_cast<const std::uint8_t *>(data);
+    auto &port = reg(ITM_STIM0);
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        std::uint32_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        while (port == 0) {
+        }
+        port = word;
+    }
+    for (; i < size; ++i) {
+        while (port == 0) {
+        }
+        *reinterpret_cast<volatile std::uint8_t *>(ITM_STIM0) = bytes[i];
+    }
+#else
+    // no ITM on the host, e.g. on the ThreadX Linux port
+    (void) data;
+    (void) size;
+#endif
+}
+
+#endif // TX_ENABLE_EVENT_TRACE
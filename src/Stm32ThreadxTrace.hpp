@@ -0,0 +1,236 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXTRACE_HPP
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXTRACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "tx_api.h"
+
+#ifdef TX_ENABLE_EVENT_TRACE
+
+/**
+ * @brief Size of the statically allocated ThreadX trace buffer in bytes.
+ */
+#ifndef STM32THREADXTHREAD_TRACE_BUFFER_SIZE
+#define STM32THREADXTHREAD_TRACE_BUFFER_SIZE 8192
+#endif
+
+/**
+ * @brief Number of object registry entries in the trace buffer, one per kernel object to be named in the trace.
+ */
+#ifndef STM32THREADXTHREAD_TRACE_REGISTRY_ENTRIES
+#define STM32THREADXTHREAD_TRACE_REGISTRY_ENTRIES 32
+#endif
+
+namespace Stm32ThreadxThread {
+    namespace native {
+        using ULONG = ULONG;
+        constexpr ULONG TRACE_USER_EVENT_START = TX_TRACE_USER_EVENT_START;
+        constexpr ULONG TRACE_USER_EVENT_END = TX_TRACE_USER_EVENT_END;
+    }
+
+    /**
+     * @class trace
+     * @brief Records the ThreadX event trace into a static buffer and streams it as compact binary records.
+     *
+     * The kernel registers every thread with its name in the object registry of the trace buffer and logs
+     * scheduling events with the running thread, so context switches are seen as changes of the thread of
+     * consecutive records. Applications add their own events with `event()`, and mark regions with
+     * `scoped_region`.
+     *
+     * The trace buffer is circular. `read()` and `drain()` convert the entries written since the previous call
+     * into `record`s, half the size of a kernel entry, which can be sent over SWO/ITM (`itmSink()`) or a UART
+     * with DMA. The consumer must keep up with the kernel, otherwise unread entries are overwritten.
+     *
+     * The stream starts with a `name_record` for every registered object, followed by `record`s, all
+     * little endian. The sequence number of a record is the position of its entry in the trace, so entries
+     * overwritten before they were read show up as gaps on the host, and are counted by `getDropped()`.
+     *
+     * @note Requires the kernel to be built with `TX_ENABLE_EVENT_TRACE`.
+     */
+    class trace {
+    public:
+        using event_id = native::ULONG;
+
+        /// Events reserved by this library, user events start at `USER_EVENT_FIRST`
+        static constexpr event_id REGION_BEGIN = native::TRACE_USER_EVENT_START;
+        static constexpr event_id REGION_END = native::TRACE_USER_EVENT_START + 1;
+        static constexpr event_id USER_EVENT_FIRST = native::TRACE_USER_EVENT_START + 16;
+        static constexpr event_id USER_EVENT_LAST = native::TRACE_USER_EVENT_END;
+
+        /// `record::event_id` of a `name_record`
+        static constexpr std::uint16_t NAME_RECORD_ID = 0xFFFF;
+
+        /**
+         * @struct record
+         * @brief Compact binary record of one trace event, 16 bytes.
+         */
+        struct record {
+            std::uint16_t event_id; ///< ThreadX event ID, or the user event ID
+            std::uint8_t priority; ///< Priority of the running thread, saturated at 255
+            std::uint8_t sequence; ///< Position of the entry in the trace, modulo 256
+            std::uint32_t thread; ///< Running thread, 0 for idle, 0xFFFFFFFF for ISRs, 0xF0F0F0F0 for initialization
+            std::uint32_t time_stamp; ///< Time stamp of `TX_TRACE_TIME_SOURCE`
+            std::uint32_t info; ///< First information field of the event
+        };
+        static_assert(sizeof(record) == 16, "record must be 16 bytes");
+
+        /**
+         * @struct name_record
+         * @brief Header of a registry entry in the stream, followed by `length` bytes of the name.
+         */
+        struct name_record {
+            std::uint16_t event_id; ///< Always `NAME_RECORD_ID`
+            std::uint8_t type; ///< ThreadX object type, 1 for threads
+            std::uint8_t length; ///< Length of the name following this header
+            std::uint32_t object; ///< Address of the object, as used by `record::thread`
+        };
+        static_assert(sizeof(name_record) == 8, "name_record must be 8 bytes");
+
+        using sink = void (*)(const void *data, std::size_t size);
+
+        /**
+         * @brief Enables the trace with the static buffer by calling `tx_trace_enable()`.
+         *
+         * Call from `tx_application_define()` before creating the threads, so all of them are registered.
+         */
+        static void enable();
+
+        /**
+         * @brief Disables the trace.
+         */
+        static void disable();
+
+        /**
+         * @brief Excludes events from the trace, see `tx_trace_event_filter()`.
+         */
+        static void filter(native::ULONG event_bits);
+
+        /**
+         * @brief Streams a `name_record` with name for every object in the registry.
+         *
+         * Call once before streaming records, and again whenever objects have been created.
+         */
+        static void drainNames(sink s);
+
+        /**
+         * @brief Converts new trace entries into records.
+         *
+         * @param buffer The buffer to fill, e.g. the source of a UART DMA transfer.
+         * @param max_records The number of records fitting into the buffer.
+         * @return The number of records written.
+         * @remark Thread context callable
+         */
+        static std::size_t read(record *buffer, std::size_t max_records);
+
+        /**
+         * @brief Get the number of entries overwritten by the kernel before they were read, since enabling.
+         */
+        static std::uint32_t getDropped();
+
+        /**
+         * @brief Passes all new trace entries as records to the sink, in chunks.
+         * @return The number of records passed.
+         * @remark Thread context callable
+         */
+        static std::size_t drain(sink s);
+
+        /**
+         * @brief Sink writing to ITM stimulus port 0, e.g. for SWO.
+         *
+         * Blocks while the port is busy, does nothing if the ITM or the port is disabled, and off target.
+         */
+        static void itmSink(const void *data, std::size_t size);
+
+        /**
+         * @brief Inserts a user event.
+         * @remark Thread and ISR context callable
+         */
+        static void event(event_id id, native::ULONG info1 = 0, native::ULONG info2 = 0,
+                          native::ULONG info3 = 0, native::ULONG info4 = 0) {
+            tx_trace_user_event_insert(id, info1, info2, info3, info4);
+        }
+
+        /**
+         * @brief Inserts a user event from an application defined enumeration.
+         *
+         * The enumerators are numbered from zero and mapped onto the user event range, e.g.
+         * `enum class app_event { adcDone, canRx };` and `trace::event(app_event::canRx, id);`
+         *
+         * @remark Thread and ISR context callable
+         */
+        template<class Enum, typename = typename std::enable_if<std::is_enum<Enum>::value>::type>
+        static void event(Enum e, native::ULONG info1 = 0, native::ULONG info2 = 0,
+                          native::ULONG info3 = 0, native::ULONG info4 = 0) {
+            event(eventId(e), info1, info2, info3, info4);
+        }
+
+        /**
+         * @brief Maps an application defined enumerator to its user event ID.
+         */
+        template<class Enum>
+        static constexpr event_id eventId(Enum e) {
+            return USER_EVENT_FIRST + static_cast<event_id>(e);
+        }
+
+        /**
+         * @brief Marks the entry of an ISR.
+         * @remark ISR context callable
+         */
+        static void isrEnter(native::ULONG isr_id) {
+            tx_trace_isr_enter_insert(isr_id);
+        }
+
+        /**
+         * @brief Marks the exit of an ISR.
+         * @remark ISR context callable
+         */
+        static void isrExit(native::ULONG isr_id) {
+            tx_trace_isr_exit_insert(isr_id);
+        }
+
+        /**
+         * @class scoped_region
+         * @brief Marks a region by a `REGION_BEGIN` and a `REGION_END` event, both with the region ID as info.
+         *
+         * The host calculates the duration of the region from the time stamps.
+         */
+        class scoped_region {
+        public:
+            explicit scoped_region(native::ULONG region_id) : region_id(region_id) {
+                event(REGION_BEGIN, region_id);
+            }
+
+            template<class Enum, typename = typename std::enable_if<std::is_enum<Enum>::value>::type>
+            explicit scoped_region(Enum region) : scoped_region(static_cast<native::ULONG>(region)) {
+            }
+
+            ~scoped_region() {
+                event(REGION_END, region_id);
+            }
+
+            scoped_region(const scoped_region &) = delete;
+
+            scoped_region &operator=(const scoped_region &) = delete;
+
+        private:
+            native::ULONG region_id;
+        };
+    };
+}
+
+#endif // TX_ENABLE_EVENT_TRACE
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXTRACE_HPP
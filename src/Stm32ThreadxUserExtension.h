@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2024 Roland Rusch, easy-smart solution GmbH <roland.rusch@easy-smart.ch>
+ *
+ * This file is part of libsmart/Stm32ThreadxThread, which is distributed under the terms
+ * of the BSD 3-Clause License. You should have received a copy of the BSD 3-Clause
+ * License along with libsmart/Stm32ThreadxThread. If not, see <https://spdx.org/licenses/BSD-3-Clause.html>.
+ */
+
+
+/**
+ * @file Stm32ThreadxUserExtension.h
+ * @brief Extends the ThreadX thread control block with the thread-local storage slots of this library.
+ *
+ * Include this header from `tx_user.h` instead of defining `TX_THREAD_USER_EXTENSION` there:
+ *
+ * @code
+ * #define STM32THREADXTHREAD_TLS_SLOTS 4
+ * #include "Stm32ThreadxUserExtension.h"
+ * @endcode
+ *
+ * Further members of the control block can be added with `STM32THREADXTHREAD_USER_EXTENSION`.
+ */
+
+#ifndef LIBSMART_STM32THREADXTHREAD_STM32THREADXUSEREXTENSION_H
+#define LIBSMART_STM32THREADXTHREAD_STM32THREADXUSEREXTENSION_H
+
+#ifdef TX_THREAD_USER_EXTENSION
+#error "TX_THREAD_USER_EXTENSION is already defined, use STM32THREADXTHREAD_USER_EXTENSION for own members"
+#endif
+
+/**
+ * @brief Number of thread-local storage slots in each thread control block.
+ */
+#ifndef STM32THREADXTHREAD_TLS_SLOTS
+#define STM32THREADXTHREAD_TLS_SLOTS 4
+#endif
+
+#ifndef STM32THREADXTHREAD_USER_EXTENSION
+#define STM32THREADXTHREAD_USER_EXTENSION
+#endif
+
+#define TX_THREAD_USER_EXTENSION \
+    VOID *tx_thread_tls_slots[STM32THREADXTHREAD_TLS_SLOTS]; \
+    STM32THREADXTHREAD_USER_EXTENSION
+
+#endif //LIBSMART_STM32THREADXTHREAD_STM32THREADXUSEREXTENSION_H